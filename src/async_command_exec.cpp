@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "async_command_exec.hpp"
+
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+extern char** environ;
+
+namespace data_sync::async
+{
+
+namespace
+{
+
+/**
+ * @brief The maximum number of bytes of the command output to be kept.
+ */
+constexpr std::size_t maxOutputSize = 4096;
+
+/**
+ * @brief The interval to check whether the command is done if its exit
+ *        can't be waited for through a pidfd.
+ */
+constexpr auto exitPollInterval = std::chrono::milliseconds(100);
+
+/**
+ * @brief A helper API to read all available data from the given
+ *        non-blocking file descriptor.
+ *
+ * @param[in] fd - The file descriptor to read
+ * @param[in,out] output - The buffer to append the read data
+ *
+ * @return true if the end of the file is reached or the read failed;
+ *         false if more data may arrive.
+ */
+bool readAvailable(int fd, std::string& output)
+{
+    std::array<char, 1024> buffer{};
+    while (true)
+    {
+        auto bytesRead = read(fd, buffer.data(), buffer.size());
+        if (bytesRead > 0)
+        {
+            if (output.size() < maxOutputSize)
+            {
+                output.append(buffer.data(),
+                              std::min(static_cast<std::size_t>(bytesRead),
+                                       maxOutputSize - output.size()));
+            }
+            continue;
+        }
+        if (bytesRead == 0)
+        {
+            return true;
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        return errno != EAGAIN && errno != EWOULDBLOCK;
+    }
+}
+
+/**
+ * @brief A helper API to reap the given child process if it is done,
+ *        without blocking.
+ *
+ * @param[in] pid - The process id of the child
+ *
+ * @return The exit status of the child, which is -1 if it didn't exit
+ *         normally or can't be waited for; nullopt if it is still running.
+ */
+std::optional<int> reapChild(pid_t pid)
+{
+    int status{0};
+    while (true)
+    {
+        const auto rc = waitpid(pid, &status, WNOHANG);
+        if (rc == 0)
+        {
+            return std::nullopt;
+        }
+        if (rc == pid)
+        {
+            return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+        }
+        if (errno != EINTR)
+        {
+            return -1;
+        }
+    }
+}
+
+/**
+ * @brief A helper API to keep the given data in an anonymous memory file.
+ *
+ * @param[in] data - The data to keep
+ *
+ * @return The memory file descriptor positioned at the beginning of the
+ *         data; -1 on failure.
+ */
+int createMemFile(std::string_view data)
+{
+    utility::FD memFD(memfd_create("data_sync_stdin", MFD_CLOEXEC));
+    if (memFD() == -1)
+    {
+        return -1;
+    }
+
+    for (std::size_t written = 0; written < data.size();)
+    {
+        auto rc = write(memFD(), data.data() + written, data.size() - written);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+        written += static_cast<std::size_t>(rc);
+    }
+
+    if (lseek(memFD(), 0, SEEK_SET) == -1)
+    {
+        return -1;
+    }
+
+    return memFD.release();
+}
+
+} // namespace
+
+sdbusplus::async::task<CmdResult> execCmd(sdbusplus::async::context& ctx,
+                                          std::vector<std::string> cmd,
+                                          std::string_view stdinData,
+                                          pid_t* runningPid)
+{
+    if (cmd.empty())
+    {
+        co_return CmdResult{-1, "Empty command"};
+    }
+
+    utility::FD stdinFD(-1);
+    if (!stdinData.empty())
+    {
+        stdinFD = utility::FD(createMemFile(stdinData));
+        if (stdinFD() == -1)
+        {
+            lg2::error("Failed to create the input of [{CMD}], errno : "
+                       "{ERRNO}",
+                       "CMD", cmd.front(), "ERRNO", errno);
+            co_return CmdResult{-1, std::strerror(errno)};
+        }
+    }
+
+    std::array<int, 2> pipeFds{-1, -1};
+    if (pipe2(pipeFds.data(), O_CLOEXEC) == -1)
+    {
+        lg2::error("Failed to create the pipe to run [{CMD}], errno : {ERRNO}",
+                   "CMD", cmd.front(), "ERRNO", errno);
+        co_return CmdResult{-1, std::strerror(errno)};
+    }
+    utility::FD readEnd(pipeFds[0]);
+    utility::FD writeEnd(pipeFds[1]);
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    if (stdinFD() != -1)
+    {
+        posix_spawn_file_actions_adddup2(&fileActions, stdinFD(),
+                                         STDIN_FILENO);
+    }
+    else
+    {
+        posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO,
+                                         "/dev/null", O_RDONLY, 0);
+    }
+    posix_spawn_file_actions_adddup2(&fileActions, writeEnd(), STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&fileActions, writeEnd(), STDERR_FILENO);
+
+    std::vector<char*> argv;
+    argv.reserve(cmd.size() + 1);
+    std::ranges::transform(cmd, std::back_inserter(argv),
+                           [](auto& arg) { return arg.data(); });
+    argv.push_back(nullptr);
+
+    pid_t pid{-1};
+    auto rc = posix_spawnp(&pid, argv.front(), &fileActions, nullptr,
+                           argv.data(), environ);
+    posix_spawn_file_actions_destroy(&fileActions);
+    if (rc != 0)
+    {
+        lg2::error("Failed to spawn [{CMD}], error : {ERROR}", "CMD",
+                   cmd.front(), "ERROR", std::strerror(rc));
+        co_return CmdResult{-1, std::strerror(rc)};
+    }
+
+    if (runningPid != nullptr)
+    {
+        *runningPid = pid;
+    }
+
+    // Only the child should hold the write end so that EOF is seen on the
+    // read end once the command is done.
+    writeEnd.reset();
+    stdinFD.reset();
+    fcntl(readEnd(), F_SETFL, fcntl(readEnd(), F_GETFL) | O_NONBLOCK);
+
+    std::string output;
+    {
+        auto fdioInstance =
+            std::make_unique<sdbusplus::async::fdio>(ctx, readEnd());
+        while (!readAvailable(readEnd(), output))
+        {
+            co_await fdioInstance->next();
+        }
+    }
+
+    // The command may still be running after closing its output, hence its
+    // exit is waited for through a pidfd, which gets readable once the
+    // command is done. The kernels without pidfd are polled instead.
+    auto exitStatus = reapChild(pid);
+    if (!exitStatus.has_value())
+    {
+        utility::FD pidFD(static_cast<int>(syscall(SYS_pidfd_open, pid, 0)));
+        std::unique_ptr<sdbusplus::async::fdio> fdioInstance;
+        if (pidFD() != -1)
+        {
+            fdioInstance =
+                std::make_unique<sdbusplus::async::fdio>(ctx, pidFD());
+        }
+        while (!(exitStatus = reapChild(pid)).has_value())
+        {
+            if (fdioInstance)
+            {
+                co_await fdioInstance->next();
+            }
+            else
+            {
+                co_await sdbusplus::async::sleep_for(ctx, exitPollInterval);
+            }
+        }
+    }
+    if (runningPid != nullptr)
+    {
+        *runningPid = -1;
+    }
+
+    co_return CmdResult{exitStatus.value(), std::move(output)};
+}
+
+} // namespace data_sync::async
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <sdbusplus/async.hpp>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace data_sync::async
+{
+
+/**
+ * @brief The exit status of a command and its combined stdout and stderr.
+ */
+using CmdResult = std::pair<int, std::string>;
+
+/**
+ * @brief Execute the given command without blocking the async context.
+ *
+ * @param[in] ctx - The async context to wait for the command output on
+ * @param[in] cmd - The command and its arguments
+ * @param[in] stdinData - The data to feed as the standard input of the
+ *                        command, which is kept in memory (memfd) rather
+ *                        than in a temporary file. It must outlive the
+ *                        returned task.
+ * @param[out] runningPid - The location to set the process id of the
+ *                          command while it runs so that the caller can
+ *                          terminate it, and -1 once it exited. It must
+ *                          outlive the returned task.
+ *
+ * @return The exit status of the command and its output. The exit status
+ *         will be -1 if the command could not be spawned or was terminated
+ *         by a signal.
+ *
+ * @note The command is spawned directly without a shell, hence the
+ *       arguments are passed as given.
+ */
+sdbusplus::async::task<CmdResult> execCmd(sdbusplus::async::context& ctx,
+                                          std::vector<std::string> cmd,
+                                          std::string_view stdinData = {},
+                                          pid_t* runningPid = nullptr);
+
+} // namespace data_sync::async
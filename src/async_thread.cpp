@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "async_thread.hpp"
+
+#include "utility.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <system_error>
+#include <thread>
+
+namespace data_sync::async
+{
+
+sdbusplus::async::task<> runInThread(sdbusplus::async::context& ctx,
+                                     std::function<void()> func)
+{
+    utility::FD doneFD(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (doneFD() == -1)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to create the eventfd");
+    }
+
+    std::exception_ptr exception;
+    {
+        // The thread signals the eventfd once done, which wakes up the
+        // async context to resume the caller.
+        std::jthread thread([&func, &exception, doneFD = doneFD()]() {
+            try
+            {
+                func();
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+
+            const std::uint64_t done = 1;
+            while (write(doneFD, &done, sizeof(done)) == -1 && errno == EINTR)
+            {}
+        });
+
+        auto fdioInstance = std::make_unique<sdbusplus::async::fdio>(ctx,
+                                                                     doneFD());
+        co_await fdioInstance->next();
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+} // namespace data_sync::async
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sdbusplus/async.hpp>
+
+#include <functional>
+
+namespace data_sync::async
+{
+
+/**
+ * @brief Run the given function in a thread without blocking the async
+ *        context, e.g. to do the blocking file system calls.
+ *
+ * @param[in] ctx - The async context to wait for the thread on
+ * @param[in] func - The function to run, which must not touch the state
+ *                   owned by the async context as it runs concurrently.
+ *
+ * @return NULL
+ *
+ * @note The exception thrown by the function is rethrown to the caller.
+ *       The thread is joined before the returned task completes, even if
+ *       the wait is cancelled.
+ */
+sdbusplus::async::task<> runInThread(sdbusplus::async::context& ctx,
+                                     std::function<void()> func);
+
+} // namespace data_sync::async
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "buffer_pool.hpp"
+
+#include <utility>
+
+namespace data_sync
+{
+
+BufferPool::Lease::Lease(Lease&& other) noexcept :
+    _pool(std::exchange(other._pool, nullptr)),
+    _buffer(std::exchange(other._buffer, {}))
+{}
+
+BufferPool::Lease& BufferPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        _pool = std::exchange(other._pool, nullptr);
+        _buffer = std::exchange(other._buffer, {});
+    }
+    return *this;
+}
+
+BufferPool::Lease::~Lease()
+{
+    release();
+}
+
+void BufferPool::Lease::release()
+{
+    if (_pool != nullptr && !_buffer.empty())
+    {
+        _pool->_freeBuffers.push_back(_buffer.data());
+    }
+    _pool = nullptr;
+    _buffer = {};
+}
+
+BufferPool::BufferPool(std::size_t bufferSize, std::size_t buffersCount) :
+    _bufferSize((bufferSize + alignof(std::max_align_t) - 1) /
+                alignof(std::max_align_t) * alignof(std::max_align_t)),
+    _storage(std::make_unique_for_overwrite<std::byte[]>(_bufferSize *
+                                                         buffersCount))
+{
+    // The free list never holds more than all the buffers, hence it
+    // doesn't allocate once the pool is built.
+    _freeBuffers.reserve(buffersCount);
+    for (std::size_t index = buffersCount; index > 0; --index)
+    {
+        _freeBuffers.push_back(_storage.get() + ((index - 1) * _bufferSize));
+    }
+}
+
+BufferPool::Lease BufferPool::acquire()
+{
+    if (_freeBuffers.empty())
+    {
+        return {};
+    }
+
+    auto* buffer = _freeBuffers.back();
+    _freeBuffers.pop_back();
+    return {*this, {buffer, _bufferSize}};
+}
+
+SyncArena::SyncArena(BufferPool& pool) :
+    _lease(pool.acquire()),
+    _resource(_lease.get().data(), _lease.get().size(),
+              std::pmr::new_delete_resource())
+{}
+
+} // namespace data_sync
@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace data_sync
+{
+
+/**
+ * @class BufferPool
+ *
+ * @brief This class hands out fixed-size buffers from a block which is
+ *        allocated once, so that the buffers needed per sync are reused
+ *        rather than allocated and freed on every sync.
+ *
+ * @note The pool never grows, which bounds the memory it takes. The caller
+ *       falls back to the heap once all the buffers are in use.
+ */
+class BufferPool
+{
+  public:
+    /**
+     * @class Lease
+     *
+     * @brief This class holds a buffer of the pool and returns it into the
+     *        pool at the end.
+     */
+    class Lease
+    {
+      public:
+        Lease() = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        /**
+         * @brief The destructor returns the buffer into the pool.
+         */
+        ~Lease();
+
+        /**
+         * @brief Get the leased buffer.
+         *
+         * @return The buffer; empty if the pool had no free buffer.
+         */
+        std::span<std::byte> get() const
+        {
+            return _buffer;
+        }
+
+      private:
+        friend class BufferPool;
+
+        /**
+         * @brief The constructor
+         *
+         * @param[in] pool - The pool to return the buffer into
+         * @param[in] buffer - The leased buffer
+         */
+        Lease(BufferPool& pool, std::span<std::byte> buffer) :
+            _pool(&pool), _buffer(buffer)
+        {}
+
+        /**
+         * @brief A helper API to return the buffer into the pool.
+         *
+         * @return NULL
+         */
+        void release();
+
+        /**
+         * @brief The pool which owns the buffer.
+         */
+        BufferPool* _pool{nullptr};
+
+        /**
+         * @brief The leased buffer.
+         */
+        std::span<std::byte> _buffer;
+    };
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+    ~BufferPool() = default;
+
+    /**
+     * @brief The constructor allocates all the buffers of the pool.
+     *
+     * @param[in] bufferSize - The size of each buffer, which is rounded up
+     *                         to keep every buffer suitably aligned
+     * @param[in] buffersCount - The number of buffers
+     */
+    BufferPool(std::size_t bufferSize, std::size_t buffersCount);
+
+    /**
+     * @brief Lease a free buffer of the pool.
+     *
+     * @return The lease of the buffer; the lease holds an empty buffer if
+     *         all the buffers are in use.
+     *
+     * @note The pool must outlive the returned lease.
+     */
+    Lease acquire();
+
+    /**
+     * @brief Get the size of each buffer.
+     *
+     * @return The buffer size.
+     */
+    std::size_t getBufferSize() const
+    {
+        return _bufferSize;
+    }
+
+    /**
+     * @brief Get the number of buffers which are not leased.
+     *
+     * @return The free buffers count.
+     */
+    std::size_t getFreeBuffersCount() const
+    {
+        return _freeBuffers.size();
+    }
+
+  private:
+    /**
+     * @brief The size of each buffer.
+     */
+    std::size_t _bufferSize;
+
+    /**
+     * @brief The block which holds all the buffers.
+     */
+    std::unique_ptr<std::byte[]> _storage;
+
+    /**
+     * @brief The buffers which are not leased.
+     */
+    std::vector<std::byte*> _freeBuffers;
+};
+
+/**
+ * @class SyncArena
+ *
+ * @brief This class provides the memory for the temporary objects of a
+ *        sync from a buffer of the pool, where the memory is released all
+ *        at once at the end of the sync.
+ *
+ * @note The objects which don't fit into the buffer (or all objects, if
+ *       the pool had no free buffer) are allocated from the heap.
+ */
+class SyncArena
+{
+  public:
+    SyncArena(const SyncArena&) = delete;
+    SyncArena& operator=(const SyncArena&) = delete;
+    SyncArena(SyncArena&&) = delete;
+    SyncArena& operator=(SyncArena&&) = delete;
+    ~SyncArena() = default;
+
+    /**
+     * @brief The constructor leases a buffer of the given pool.
+     *
+     * @param[in] pool - The pool to take the buffer from
+     */
+    explicit SyncArena(BufferPool& pool);
+
+    /**
+     * @brief Get the memory resource of the arena.
+     *
+     * @return The memory resource, which must not be used beyond the
+     *         lifetime of the arena.
+     */
+    std::pmr::memory_resource* get()
+    {
+        return &_resource;
+    }
+
+  private:
+    /**
+     * @brief The lease of the buffer backing the arena.
+     */
+    BufferPool::Lease _lease;
+
+    /**
+     * @brief The memory resource over the leased buffer.
+     */
+    std::pmr::monotonic_buffer_resource _resource;
+};
+
+} // namespace data_sync
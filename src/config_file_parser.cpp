@@ -0,0 +1,450 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config_file_parser.hpp"
+
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace data_sync::config
+{
+
+namespace
+{
+
+/**
+ * @class ConfigSAXHandler
+ *
+ * @brief The SAX handler which builds the data sync config of each file
+ *        and directory in the configuration as the JSON content is parsed.
+ *
+ * @note The properties which are not required to sync (e.g. Description)
+ *       and the unknown sections are skipped.
+ */
+class ConfigSAXHandler : public nlohmann::json_sax<nlohmann::json>
+{
+  public:
+    /**
+     * @brief The constructor
+     *
+     * @param[out] dataSyncConfigs - The list to add the parsed config into
+     */
+    explicit ConfigSAXHandler(std::vector<DataSyncConfig>& dataSyncConfigs) :
+        _dataSyncConfigs(dataSyncConfigs)
+    {}
+
+    bool null() override
+    {
+        return onOtherValue();
+    }
+
+    bool boolean(bool /*val*/) override
+    {
+        return onOtherValue();
+    }
+
+    bool number_integer(number_integer_t val) override
+    {
+        if (val < 0)
+        {
+            return onOtherValue();
+        }
+        return number_unsigned(static_cast<number_unsigned_t>(val));
+    }
+
+    bool number_unsigned(number_unsigned_t val) override
+    {
+        if (isListValue())
+        {
+            throwUnexpectedValue();
+        }
+        if (!isEntryValue())
+        {
+            return true;
+        }
+
+        visitField([this, val](auto& field) {
+            using Value = RawFieldValueT<std::remove_cvref_t<decltype(field)>>;
+            if constexpr (std::is_integral_v<Value>)
+            {
+                field = checkRange<Value>(val);
+            }
+            else
+            {
+                throwUnexpectedValue();
+            }
+        });
+        return true;
+    }
+
+    bool number_float(number_float_t /*val*/,
+                      const string_t& /*s*/) override
+    {
+        return onOtherValue();
+    }
+
+    bool string(string_t& val) override
+    {
+        if (isListValue())
+        {
+            _list->emplace_back(std::move(val));
+            return true;
+        }
+        if (!isEntryValue())
+        {
+            return true;
+        }
+
+        visitField([this, &val](auto& field) {
+            using Value = RawFieldValueT<std::remove_cvref_t<decltype(field)>>;
+            if constexpr (std::is_same_v<Value, std::string>)
+            {
+                field = std::move(val);
+            }
+            else
+            {
+                throwUnexpectedValue();
+            }
+        });
+        return true;
+    }
+
+    bool binary(binary_t& /*val*/) override
+    {
+        return onOtherValue();
+    }
+
+    bool start_object(std::size_t /*elements*/) override
+    {
+        onOtherValue();
+        if (++_depth == entryDepth && _section != Section::None)
+        {
+            _entry = RawDataSyncConfig{};
+        }
+        return true;
+    }
+
+    bool end_object() override
+    {
+        if (_depth-- == entryDepth && _section != Section::None)
+        {
+            if (_entry._path.empty() || _entry._syncDirection.empty() ||
+                _entry._syncType.empty())
+            {
+                throw std::invalid_argument(
+                    "Missing the required property [Path, SyncDirection, "
+                    "SyncType] of the data to sync");
+            }
+            _dataSyncConfigs.emplace_back(std::move(_entry),
+                                          _section == Section::Directories);
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t /*elements*/) override
+    {
+        if (isEntryValue())
+        {
+            visitField([this](auto& field) {
+                using Field = std::remove_cvref_t<decltype(field)>;
+                if constexpr (std::is_same_v<Field,
+                                             std::optional<std::vector<
+                                                 std::string>>>)
+                {
+                    _list = &field.emplace();
+                }
+                else
+                {
+                    throwUnexpectedValue();
+                }
+            });
+        }
+        else if (isListValue())
+        {
+            throwUnexpectedValue();
+        }
+        ++_depth;
+        return true;
+    }
+
+    bool end_array() override
+    {
+        if (_depth-- == listDepth)
+        {
+            _list = nullptr;
+        }
+        return true;
+    }
+
+    bool key(string_t& val) override
+    {
+        if (_depth == sectionDepth)
+        {
+            _section = val == "Files"         ? Section::Files
+                       : val == "Directories" ? Section::Directories
+                                              : Section::None;
+        }
+        else if (_depth == entryDepth)
+        {
+            _key = std::move(val);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t /*position*/, const std::string& /*token*/,
+                     const nlohmann::detail::exception& ex) override
+    {
+        throw std::invalid_argument(ex.what());
+    }
+
+  private:
+    /**
+     * @brief The sections of the configuration which list the data.
+     */
+    enum class Section
+    {
+        None,
+        Files,
+        Directories
+    };
+
+    /**
+     * @brief The nesting depths of the configuration, where the depth of
+     *        the top level object is 1.
+     */
+    static constexpr int sectionDepth = 1;
+    static constexpr int entryDepth = 3;
+    static constexpr int listDepth = 4;
+
+    /**
+     * @brief A helper API to check whether the value being parsed is a
+     *        property of a file or directory.
+     */
+    bool isEntryValue() const
+    {
+        return _section != Section::None && _depth == entryDepth;
+    }
+
+    /**
+     * @brief A helper API to check whether the value being parsed is an
+     *        element of the exclude or include list.
+     */
+    bool isListValue() const
+    {
+        return _list != nullptr && _depth == listDepth;
+    }
+
+    /**
+     * @brief A helper API to check whether the current property is used to
+     *        sync, so a value of an unexpected type has to be reported.
+     */
+    bool isKnownKey() const
+    {
+        bool isKnown = false;
+        RawDataSyncConfig::forEachField(
+            [this, &isKnown](const char* name, auto /*field*/) {
+            isKnown = isKnown || _key == name;
+        });
+        return isKnown;
+    }
+
+    /**
+     * @brief A helper API to call the given function with the field of the
+     *        current property, if it is used to sync.
+     *
+     * @param[in] func - The function to call as func(field)
+     */
+    template <typename Func>
+    void visitField(Func&& func)
+    {
+        RawDataSyncConfig::forEachField(
+            [this, &func](const char* name, auto field) {
+            if (_key == name)
+            {
+                func(_entry.*field);
+            }
+        });
+    }
+
+    /**
+     * @brief A helper API to handle the values which are not expected for
+     *        any property used to sync.
+     *
+     * @return true to continue parsing.
+     */
+    bool onOtherValue()
+    {
+        if (isListValue() || (isEntryValue() && isKnownKey()))
+        {
+            throwUnexpectedValue();
+        }
+        return true;
+    }
+
+    /**
+     * @brief A helper API to report the value of an unexpected type for the
+     *        current property.
+     */
+    [[noreturn]] void throwUnexpectedValue() const
+    {
+        throw std::invalid_argument("Unexpected value type of the property [" +
+                                    _key + "]");
+    }
+
+    /**
+     * @brief A helper API to check whether the given value fits into the
+     *        field of the current property.
+     */
+    template <typename T>
+    T checkRange(number_unsigned_t val) const
+    {
+        if (val > std::numeric_limits<T>::max())
+        {
+            throw std::out_of_range("The value of the property [" + _key +
+                                    "] is out of range");
+        }
+        return static_cast<T>(val);
+    }
+
+    /**
+     * @brief The list to add the parsed config into.
+     */
+    std::vector<DataSyncConfig>& _dataSyncConfigs;
+
+    /**
+     * @brief The nesting depth of the value being parsed.
+     */
+    int _depth{0};
+
+    /**
+     * @brief The section being parsed.
+     */
+    Section _section{Section::None};
+
+    /**
+     * @brief The property of the file or directory being parsed.
+     */
+    std::string _key;
+
+    /**
+     * @brief The values of the file or directory being parsed.
+     */
+    RawDataSyncConfig _entry;
+
+    /**
+     * @brief The exclude or include list being parsed.
+     */
+    std::vector<std::string>* _list{nullptr};
+};
+
+} // namespace
+
+std::vector<DataSyncConfig> parseConfigContent(std::string_view configContent)
+{
+    std::vector<DataSyncConfig> dataSyncConfigs;
+    ConfigSAXHandler handler(dataSyncConfigs);
+    nlohmann::json::sax_parse(configContent, &handler);
+    return dataSyncConfigs;
+}
+
+std::vector<DataSyncConfig>
+    parseConfigFile(const std::filesystem::path& configFile)
+{
+    utility::FD fd(open(configFile.c_str(), O_RDONLY | O_CLOEXEC));
+    struct stat fileStat{};
+    if (fd() == -1 || fstat(fd(), &fileStat) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to open " + configFile.string());
+    }
+
+    std::string configContent(static_cast<std::size_t>(fileStat.st_size),
+                              '\0');
+    std::size_t bytesRead = 0;
+    while (bytesRead < configContent.size())
+    {
+        const auto result = read(fd(), configContent.data() + bytesRead,
+                                 configContent.size() - bytesRead);
+        if (result == 0)
+        {
+            break;
+        }
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to read " + configFile.string());
+        }
+        bytesRead += static_cast<std::size_t>(result);
+    }
+    configContent.resize(bytesRead);
+
+    return parseConfigContent(configContent);
+}
+
+std::vector<DataSyncConfig>
+    parseConfigDir(const std::filesystem::path& configDir, bool& isAllParsed)
+{
+    std::vector<std::vector<DataSyncConfig>> dataSyncCfgsPerFile;
+    isAllParsed = true;
+    auto parse = [&dataSyncCfgsPerFile,
+                  &isAllParsed](const auto& configFile) {
+        try
+        {
+            dataSyncCfgsPerFile.emplace_back(
+                parseConfigFile(configFile.path()));
+        }
+        catch (const std::exception& e)
+        {
+            // TODO Create error log
+            lg2::error("Failed to parse the configuration file : {CONFIG_FILE},"
+                       " exception : {EXCEPTION}",
+                       "CONFIG_FILE", configFile.path(), "EXCEPTION", e);
+            isAllParsed = false;
+        }
+    };
+
+    // The files are parsed in the order of their names, so that the same
+    // one of the paths configured more than once is synced on every start.
+    if (std::filesystem::exists(configDir) &&
+        std::filesystem::is_directory(configDir))
+    {
+        std::vector<std::filesystem::directory_entry> configFiles(
+            std::filesystem::directory_iterator(configDir), {});
+        std::ranges::sort(configFiles);
+        std::ranges::for_each(configFiles, parse);
+    }
+
+    std::size_t totalEntries = 0;
+    for (const auto& dataSyncCfgs : dataSyncCfgsPerFile)
+    {
+        totalEntries += dataSyncCfgs.size();
+    }
+    std::vector<DataSyncConfig> dataSyncConfigs;
+    dataSyncConfigs.reserve(totalEntries);
+    for (auto& dataSyncCfgs : dataSyncCfgsPerFile)
+    {
+        std::ranges::move(dataSyncCfgs, std::back_inserter(dataSyncConfigs));
+    }
+    return dataSyncConfigs;
+}
+
+} // namespace data_sync::config
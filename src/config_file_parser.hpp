@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "data_sync_config.hpp"
+
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace data_sync::config
+{
+
+/**
+ * @brief Parse the given content of a data sync configuration file.
+ *
+ * @param[in] configContent - The configuration in JSON format
+ *
+ * @return The data sync config of all files and directories in the
+ *         configuration.
+ *
+ * @throw std::invalid_argument if the content is not a valid JSON or a
+ *        file or directory is missing a required property, and
+ *        std::out_of_range if a property has an unexpected value.
+ *
+ * @note The content is parsed through the SAX interface directly into the
+ *       data sync config without building the JSON object of the content.
+ */
+std::vector<DataSyncConfig> parseConfigContent(std::string_view configContent);
+
+/**
+ * @brief Read and parse the given data sync configuration file.
+ *
+ * @param[in] configFile - The data sync configuration file
+ *
+ * @return The data sync config of all files and directories in the
+ *         configuration file.
+ *
+ * @throw std::system_error if the file can't be read, and the exceptions
+ *        of parseConfigContent().
+ *
+ * @note The file is read at once rather than through a stream.
+ */
+std::vector<DataSyncConfig>
+    parseConfigFile(const std::filesystem::path& configFile);
+
+/**
+ * @brief Parse all the data sync configuration files in the given
+ *        directory.
+ *
+ * @param[in] configDir - The data sync configuration directory
+ * @param[out] isAllParsed - Whether all the files are parsed
+ *
+ * @return The data sync config of all the parsed files, in the order of
+ *         the file names.
+ *
+ * @note It will continue parsing all files even if one file fails to parse.
+ *       Of the paths configured more than once, the one which comes first
+ *       is to be synced, hence the same one is picked on every start.
+ */
+std::vector<DataSyncConfig>
+    parseConfigDir(const std::filesystem::path& configDir, bool& isAllParsed);
+
+} // namespace data_sync::config
@@ -0,0 +1,386 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config_snapshot.hpp"
+
+#include "build_id.h"
+#include "config.h"
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+
+namespace data_sync::config
+{
+
+namespace
+{
+
+/**
+ * @brief The identifier and the format version of the snapshot, the version
+ *        has to be incremented whenever the format changes.
+ */
+constexpr std::uint32_t snapshotMagic = 0x43534450; // "PDSC"
+constexpr std::uint32_t snapshotVersion = 5;
+
+/**
+ * @brief Get the identifier of the parser which builds the snapshot, i.e.
+ *        the build along with the build time defaults applied while parsing.
+ *
+ * @return The parser identifier
+ *
+ * @note The snapshot of another parser is stale even if the configuration
+ *       files are unchanged, as it may hold the entries parsed differently.
+ */
+std::string getParserId()
+{
+    return std::string(DATA_SYNC_BUILD_ID) +
+           ";retry_interval=" + std::to_string(DEFAULT_RETRY_INTERVAL);
+}
+
+/**
+ * @class SnapshotWriter
+ *
+ * @brief A helper to encode the values in little endian into the snapshot.
+ */
+class SnapshotWriter
+{
+  public:
+    template <typename T>
+        requires std::is_integral_v<T>
+    void write(T value)
+    {
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = std::byteswap(value);
+        }
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void write(std::string_view value)
+    {
+        write(static_cast<std::uint32_t>(value.size()));
+        _data.append(value);
+    }
+
+    void write(const std::vector<std::string>& values)
+    {
+        write(static_cast<std::uint32_t>(values.size()));
+        std::ranges::for_each(values,
+                              [this](const auto& value) { write(value); });
+    }
+
+    template <typename T>
+    void write(const std::optional<T>& value)
+    {
+        write(static_cast<std::uint8_t>(value.has_value()));
+        if (value.has_value())
+        {
+            write(value.value());
+        }
+    }
+
+    const std::string& data() const
+    {
+        return _data;
+    }
+
+  private:
+    std::string _data;
+};
+
+/**
+ * @class SnapshotReader
+ *
+ * @brief A helper to decode the values from the snapshot.
+ *
+ * @note std::out_of_range is thrown if the snapshot is truncated.
+ */
+class SnapshotReader
+{
+  public:
+    explicit SnapshotReader(std::string_view data) : _data(data) {}
+
+    template <typename T>
+        requires std::is_integral_v<T>
+    void read(T& value)
+    {
+        std::memcpy(&value, take(sizeof(value)).data(), sizeof(value));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = std::byteswap(value);
+        }
+    }
+
+    void read(std::string& value)
+    {
+        std::uint32_t size{0};
+        read(size);
+        value = take(size);
+    }
+
+    void read(std::vector<std::string>& values)
+    {
+        std::uint32_t size{0};
+        read(size);
+        values.resize(std::min<std::size_t>(size, _data.size()));
+        if (values.size() != size)
+        {
+            throw std::out_of_range("Invalid list size in the snapshot");
+        }
+        std::ranges::for_each(values, [this](auto& value) { read(value); });
+    }
+
+    template <typename T>
+    void read(std::optional<T>& value)
+    {
+        std::uint8_t hasValue{0};
+        read(hasValue);
+        if (hasValue != 0)
+        {
+            read(value.emplace());
+        }
+        else
+        {
+            value.reset();
+        }
+    }
+
+    bool empty() const
+    {
+        return _data.empty();
+    }
+
+  private:
+    std::string_view take(std::size_t size)
+    {
+        if (size > _data.size())
+        {
+            throw std::out_of_range("The snapshot is truncated");
+        }
+        auto value = _data.substr(0, size);
+        _data.remove_prefix(size);
+        return value;
+    }
+
+    std::string_view _data;
+};
+
+/**
+ * @class MappedFile
+ *
+ * @brief A RAII wrapper to memory-map a file to read.
+ */
+class MappedFile
+{
+  public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    explicit MappedFile(const fs::path& path)
+    {
+        utility::FD fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        struct stat fileStat{};
+        if (fd() == -1 || fstat(fd(), &fileStat) == -1 ||
+            fileStat.st_size == 0)
+        {
+            return;
+        }
+
+        const auto size = static_cast<std::size_t>(fileStat.st_size);
+        auto* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd(), 0);
+        if (addr != MAP_FAILED)
+        {
+            _data = std::string_view(static_cast<const char*>(addr), size);
+        }
+    }
+
+    ~MappedFile()
+    {
+        if (!_data.empty())
+        {
+            munmap(const_cast<char*>(_data.data()), _data.size());
+        }
+    }
+
+    std::string_view data() const
+    {
+        return _data;
+    }
+
+  private:
+    std::string_view _data;
+};
+
+} // namespace
+
+ConfigSnapshot::ConfigSnapshot(const fs::path& snapshotFile) :
+    _snapshotFile(snapshotFile)
+{}
+
+std::optional<std::vector<DataSyncConfig>>
+    ConfigSnapshot::load(const fs::path& dataSyncCfgDir) const
+{
+    MappedFile snapshot(_snapshotFile);
+    if (snapshot.data().empty())
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        SnapshotReader reader(snapshot.data());
+        std::uint32_t magic{0};
+        std::uint32_t version{0};
+        reader.read(magic);
+        reader.read(version);
+        if (magic != snapshotMagic || version != snapshotVersion)
+        {
+            return std::nullopt;
+        }
+
+        std::string parserId;
+        reader.read(parserId);
+        if (parserId != getParserId())
+        {
+            lg2::info("The config snapshot is of another build : {PARSER_ID}, "
+                      "parsing the configuration files",
+                      "PARSER_ID", parserId);
+            return std::nullopt;
+        }
+
+        std::uint32_t fileCount{0};
+        reader.read(fileCount);
+        if (fileCount > snapshot.data().size())
+        {
+            throw std::out_of_range("Invalid file count in the snapshot");
+        }
+        std::vector<ConfigFileState> snapshotFileStates(fileCount);
+        for (auto& fileState : snapshotFileStates)
+        {
+            reader.read(fileState._name);
+            reader.read(fileState._size);
+            reader.read(fileState._mtimeInNsec);
+        }
+        if (snapshotFileStates != getConfigFileStates(dataSyncCfgDir))
+        {
+            lg2::info("The config snapshot is stale, parsing the "
+                      "configuration files");
+            return std::nullopt;
+        }
+
+        std::uint32_t entryCount{0};
+        reader.read(entryCount);
+        if (entryCount > snapshot.data().size())
+        {
+            throw std::out_of_range("Invalid entry count in the snapshot");
+        }
+        std::vector<DataSyncConfig> dataSyncConfigs;
+        dataSyncConfigs.reserve(entryCount);
+        for (std::uint32_t index = 0; index < entryCount; ++index)
+        {
+            std::uint8_t isPathDir{0};
+            RawDataSyncConfig rawConfig;
+            reader.read(isPathDir);
+            RawDataSyncConfig::forEachField(
+                [&reader, &rawConfig](const char* /*name*/, auto field) {
+                reader.read(rawConfig.*field);
+            });
+            dataSyncConfigs.emplace_back(std::move(rawConfig), isPathDir != 0);
+        }
+        if (!reader.empty())
+        {
+            throw std::out_of_range("Unexpected data at the end");
+        }
+        return dataSyncConfigs;
+    }
+    catch (const std::exception& e)
+    {
+        lg2::error("Failed to load the config snapshot : {SNAPSHOT_FILE}, "
+                   "exception : {EXCEPTION}",
+                   "SNAPSHOT_FILE", _snapshotFile, "EXCEPTION", e);
+        return std::nullopt;
+    }
+}
+
+bool ConfigSnapshot::save(
+    const fs::path& dataSyncCfgDir,
+    const std::vector<DataSyncConfig>& dataSyncConfigs) const
+{
+    SnapshotWriter writer;
+    writer.write(snapshotMagic);
+    writer.write(snapshotVersion);
+    writer.write(getParserId());
+
+    const auto fileStates = getConfigFileStates(dataSyncCfgDir);
+    writer.write(static_cast<std::uint32_t>(fileStates.size()));
+    for (const auto& fileState : fileStates)
+    {
+        writer.write(fileState._name);
+        writer.write(fileState._size);
+        writer.write(fileState._mtimeInNsec);
+    }
+
+    writer.write(static_cast<std::uint32_t>(dataSyncConfigs.size()));
+    for (const auto& dataSyncCfg : dataSyncConfigs)
+    {
+        const auto rawConfig = dataSyncCfg.getRawDataSyncConfig();
+        writer.write(static_cast<std::uint8_t>(dataSyncCfg._isPathDir));
+        RawDataSyncConfig::forEachField(
+            [&writer, &rawConfig](const char* /*name*/, auto field) {
+            writer.write(rawConfig.*field);
+        });
+    }
+
+    // Replace the snapshot atomically to not leave a partially written
+    // snapshot if the service gets killed in between.
+    if (const auto ec =
+            utility::writeFileAtomically(_snapshotFile, writer.data());
+        ec)
+    {
+        lg2::error("Failed to save the config snapshot : {SNAPSHOT_FILE}, "
+                   "error : {ERROR}",
+                   "SNAPSHOT_FILE", _snapshotFile, "ERROR", ec.message());
+        return false;
+    }
+    return true;
+}
+
+std::vector<ConfigSnapshot::ConfigFileState>
+    ConfigSnapshot::getConfigFileStates(const fs::path& dataSyncCfgDir)
+{
+    std::vector<ConfigFileState> fileStates;
+    std::error_code ec;
+    for (auto it = fs::directory_iterator(dataSyncCfgDir, ec);
+         !ec && it != fs::directory_iterator(); it.increment(ec))
+    {
+        const auto size = it->file_size(ec);
+        const auto mtime = it->last_write_time(ec);
+        if (ec)
+        {
+            // Treat as changed by not matching with any snapshot.
+            fileStates.emplace_back(it->path().filename().string(), 0, -1);
+            ec.clear();
+            continue;
+        }
+        fileStates.emplace_back(
+            it->path().filename().string(), size,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                mtime.time_since_epoch())
+                .count());
+    }
+    std::ranges::sort(fileStates, {}, &ConfigFileState::_name);
+    return fileStates;
+}
+
+} // namespace data_sync::config
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "data_sync_config.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace data_sync::config
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class ConfigSnapshot
+ *
+ * @brief This class keeps a compact binary snapshot of the data sync config
+ *        parsed from the configuration files, so that the service start
+ *        doesn't need to parse the JSON files which change only with the
+ *        image.
+ *
+ * @note The snapshot records the name, size and modification time of each
+ *       configuration file and is considered stale if any of them differs
+ *       from the configuration directory, in which case the configuration
+ *       files have to be parsed again.
+ */
+class ConfigSnapshot
+{
+  public:
+    /**
+     * @brief The constructor
+     *
+     * @param[in] snapshotFile - The file in which the snapshot is kept
+     */
+    explicit ConfigSnapshot(const fs::path& snapshotFile);
+
+    /**
+     * @brief Load the data sync config from the snapshot.
+     *
+     * @param[in] dataSyncCfgDir - The data sync configuration directory
+     *
+     * @return The data sync config of all files and directories on success;
+     *         nullopt if the snapshot doesn't exist, is stale or corrupted.
+     *
+     * @note The snapshot file is memory-mapped to read.
+     */
+    std::optional<std::vector<DataSyncConfig>>
+        load(const fs::path& dataSyncCfgDir) const;
+
+    /**
+     * @brief Save the given data sync config as the snapshot of the given
+     *        configuration directory.
+     *
+     * @param[in] dataSyncCfgDir - The data sync configuration directory
+     * @param[in] dataSyncConfigs - The data sync config parsed from the
+     *                              configuration directory
+     *
+     * @return true on success.
+     */
+    bool save(const fs::path& dataSyncCfgDir,
+              const std::vector<DataSyncConfig>& dataSyncConfigs) const;
+
+  private:
+    /**
+     * @brief The details of a configuration file.
+     */
+    struct ConfigFileState
+    {
+        std::string _name;
+        std::uintmax_t _size;
+        std::int64_t _mtimeInNsec;
+
+        bool operator==(const ConfigFileState&) const = default;
+    };
+
+    /**
+     * @brief A helper API to get the details of the configuration files in
+     *        the given directory.
+     *
+     * @param[in] dataSyncCfgDir - The data sync configuration directory
+     *
+     * @return The details of the configuration files sorted by name.
+     */
+    static std::vector<ConfigFileState>
+        getConfigFileStates(const fs::path& dataSyncCfgDir);
+
+    /**
+     * @brief The file in which the snapshot is kept.
+     */
+    fs::path _snapshotFile;
+};
+
+} // namespace data_sync::config
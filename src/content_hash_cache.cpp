@@ -0,0 +1,410 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "content_hash_cache.hpp"
+
+#include "async_thread.hpp"
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <ranges>
+
+namespace data_sync
+{
+
+namespace
+{
+
+/**
+ * @class XXH64
+ *
+ * @brief The streaming implementation of the XXH64 hash algorithm.
+ */
+class XXH64
+{
+  public:
+    XXH64() :
+        _accumulators{prime1 + prime2, prime2, 0, std::uint64_t{0} - prime1}
+    {}
+
+    /**
+     * @brief Add the given data into the hash.
+     *
+     * @param[in] data - The data to hash
+     */
+    void update(std::string_view data)
+    {
+        _totalLength += data.size();
+
+        if (_bufferedLength > 0)
+        {
+            const auto toCopy =
+                std::min(data.size(), stripeSize - _bufferedLength);
+            std::memcpy(_buffer.data() + _bufferedLength, data.data(), toCopy);
+            _bufferedLength += toCopy;
+            data.remove_prefix(toCopy);
+            if (_bufferedLength < stripeSize)
+            {
+                return;
+            }
+            consumeStripe(_buffer.data());
+            _bufferedLength = 0;
+        }
+
+        while (data.size() >= stripeSize)
+        {
+            consumeStripe(data.data());
+            data.remove_prefix(stripeSize);
+        }
+
+        std::memcpy(_buffer.data(), data.data(), data.size());
+        _bufferedLength = data.size();
+    }
+
+    /**
+     * @brief Get the hash of the data added so far.
+     *
+     * @return The hash value.
+     */
+    std::uint64_t digest() const
+    {
+        std::uint64_t hash{0};
+        if (_totalLength >= stripeSize)
+        {
+            hash = std::rotl(_accumulators[0], 1) +
+                   std::rotl(_accumulators[1], 7) +
+                   std::rotl(_accumulators[2], 12) +
+                   std::rotl(_accumulators[3], 18);
+            for (const auto accumulator : _accumulators)
+            {
+                hash ^= round(0, accumulator);
+                hash = hash * prime1 + prime4;
+            }
+        }
+        else
+        {
+            hash = prime5;
+        }
+        hash += _totalLength;
+
+        std::size_t offset = 0;
+        for (; offset + 8 <= _bufferedLength; offset += 8)
+        {
+            hash ^= round(0, read64(_buffer.data() + offset));
+            hash = std::rotl(hash, 27) * prime1 + prime4;
+        }
+        if (offset + 4 <= _bufferedLength)
+        {
+            hash ^= read32(_buffer.data() + offset) * prime1;
+            hash = std::rotl(hash, 23) * prime2 + prime3;
+            offset += 4;
+        }
+        for (; offset < _bufferedLength; ++offset)
+        {
+            hash ^= static_cast<unsigned char>(_buffer[offset]) * prime5;
+            hash = std::rotl(hash, 11) * prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+  private:
+    static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr std::uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr std::uint64_t prime3 = 0x165667B19E3779F9ULL;
+    static constexpr std::uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr std::uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+    static constexpr std::size_t stripeSize = 32;
+
+    static std::uint64_t round(std::uint64_t accumulator, std::uint64_t input)
+    {
+        accumulator += input * prime2;
+        accumulator = std::rotl(accumulator, 31);
+        return accumulator * prime1;
+    }
+
+    static std::uint64_t read64(const char* data)
+    {
+        std::uint64_t value{0};
+        std::memcpy(&value, data, sizeof(value));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = __builtin_bswap64(value);
+        }
+        return value;
+    }
+
+    static std::uint64_t read32(const char* data)
+    {
+        std::uint32_t value{0};
+        std::memcpy(&value, data, sizeof(value));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            value = __builtin_bswap32(value);
+        }
+        return value;
+    }
+
+    void consumeStripe(const char* stripe)
+    {
+        for (std::size_t lane = 0; lane < _accumulators.size(); ++lane)
+        {
+            _accumulators[lane] =
+                round(_accumulators[lane], read64(stripe + (lane * 8)));
+        }
+    }
+
+    std::array<std::uint64_t, 4> _accumulators;
+    std::array<char, stripeSize> _buffer{};
+    std::size_t _bufferedLength{0};
+    std::uint64_t _totalLength{0};
+};
+
+} // namespace
+
+ContentHashCache::ContentHashCache(const fs::path& persistFile) :
+    _persistFile(persistFile)
+{
+    std::error_code ec;
+    if (!fs::exists(_persistFile, ec))
+    {
+        return;
+    }
+
+    try
+    {
+        std::ifstream file(_persistFile);
+        const auto cacheJSON = nlohmann::json::parse(file);
+        for (const auto& [path, destStates] : cacheJSON.items())
+        {
+            auto& fileStates = _fileStates[path];
+            for (const auto& [dest, state] : destStates.items())
+            {
+                fileStates.emplace(
+                    dest, FileState{state.at(0).get<std::uintmax_t>(),
+                                    state.at(1).get<std::int64_t>(),
+                                    state.at(2).get<std::uint64_t>()});
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // Start with an empty cache, the files will be synced again.
+        lg2::error("Failed to load the content hash cache : {CACHE_FILE}, "
+                   "exception : {EXCEPTION}",
+                   "CACHE_FILE", _persistFile, "EXCEPTION", e);
+        _fileStates.clear();
+    }
+}
+
+sdbusplus::async::task<std::optional<FileState>>
+    ContentHashCache::getFileState(sdbusplus::async::context& ctx,
+                                   const fs::path& path) const
+{
+    auto fileState = getUnhashedFileState(path);
+    if (!fileState.has_value() || fileState->second)
+    {
+        co_return fileState.transform(
+            [](const auto& entry) { return entry.first; });
+    }
+
+    // The cache is owned by the async context, hence only the reading of
+    // the file runs in the thread.
+    std::optional<std::uint64_t> hash;
+    co_await async::runInThread(ctx,
+                                [&path, &hash]() { hash = hashFile(path); });
+    if (!hash.has_value())
+    {
+        co_return std::nullopt;
+    }
+
+    fileState->first._hash = hash.value();
+    co_return fileState->first;
+}
+
+std::optional<FileState>
+    ContentHashCache::getFileState(const fs::path& path) const
+{
+    auto fileState = getUnhashedFileState(path);
+    if (!fileState.has_value() || fileState->second)
+    {
+        return fileState.transform(
+            [](const auto& entry) { return entry.first; });
+    }
+
+    auto hash = hashFile(path);
+    if (!hash.has_value())
+    {
+        return std::nullopt;
+    }
+
+    fileState->first._hash = hash.value();
+    return fileState->first;
+}
+
+std::optional<std::pair<FileState, bool>>
+    ContentHashCache::getUnhashedFileState(const fs::path& path) const
+{
+    std::error_code ec;
+    const auto status = fs::symlink_status(path, ec);
+    if (ec || !fs::is_regular_file(status))
+    {
+        return std::nullopt;
+    }
+
+    const auto size = fs::file_size(path, ec);
+    if (ec || size > maxHashableFileSize)
+    {
+        return std::nullopt;
+    }
+
+    const auto mtime = fs::last_write_time(path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+    const auto mtimeInNsec =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            mtime.time_since_epoch())
+            .count();
+
+    // Avoid reading the file if it is not touched since its last sync to
+    // any destination, as the hash depends on the content alone.
+    if (auto cachedIt = _fileStates.find(path.string());
+        cachedIt != _fileStates.end())
+    {
+        for (const auto& cachedState : cachedIt->second | std::views::values)
+        {
+            if (cachedState._size == size &&
+                cachedState._mtimeInNsec == mtimeInNsec)
+            {
+                return std::make_pair(cachedState, true);
+            }
+        }
+    }
+
+    return std::make_pair(FileState{size, mtimeInNsec, 0}, false);
+}
+
+bool ContentHashCache::isUnchanged(const fs::path& path, const fs::path& dest,
+                                   const FileState& fileState) const
+{
+    auto cachedIt = _fileStates.find(path.string());
+    if (cachedIt == _fileStates.end())
+    {
+        return false;
+    }
+    auto destIt = cachedIt->second.find(dest.string());
+    return destIt != cachedIt->second.end() &&
+           destIt->second._size == fileState._size &&
+           destIt->second._hash == fileState._hash;
+}
+
+void ContentHashCache::update(const fs::path& path, const fs::path& dest,
+                              const FileState& fileState)
+{
+    auto [cachedIt, isNew] =
+        _fileStates[path.string()].try_emplace(dest.string(), fileState);
+    if (isNew || cachedIt->second != fileState)
+    {
+        cachedIt->second = fileState;
+        _isDirty = true;
+    }
+}
+
+void ContentHashCache::remove(const fs::path& path)
+{
+    const auto prefix = path.string() + '/';
+    _isDirty |= std::erase_if(_fileStates, [&path, &prefix](const auto& entry) {
+        return entry.first == path.string() || entry.first.starts_with(prefix);
+    }) > 0;
+}
+
+void ContentHashCache::persist()
+{
+    if (!_isDirty)
+    {
+        return;
+    }
+
+    nlohmann::json cacheJSON = nlohmann::json::object();
+    for (const auto& [path, destStates] : _fileStates)
+    {
+        auto& destStatesJSON = cacheJSON[path];
+        for (const auto& [dest, state] : destStates)
+        {
+            destStatesJSON[dest] = {state._size, state._mtimeInNsec,
+                                    state._hash};
+        }
+    }
+
+    // Replace the cache atomically to not leave a partially written cache
+    // if the service gets killed in between.
+    if (const auto ec =
+            utility::writeFileAtomically(_persistFile, cacheJSON.dump());
+        ec)
+    {
+        lg2::error("Failed to persist the content hash cache : {CACHE_FILE}, "
+                   "error : {ERROR}",
+                   "CACHE_FILE", _persistFile, "ERROR", ec.message());
+        return;
+    }
+
+    _isDirty = false;
+}
+
+std::uint64_t ContentHashCache::hash(std::string_view data)
+{
+    XXH64 hasher;
+    hasher.update(data);
+    return hasher.digest();
+}
+
+std::optional<std::uint64_t> ContentHashCache::hashFile(const fs::path& path)
+{
+    utility::FD fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd() == -1)
+    {
+        return std::nullopt;
+    }
+
+    XXH64 hasher;
+    std::array<char, 64 * 1024> buffer{};
+    while (true)
+    {
+        const auto bytesRead = read(fd(), buffer.data(), buffer.size());
+        if (bytesRead == 0)
+        {
+            break;
+        }
+        if (bytesRead < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return std::nullopt;
+        }
+        hasher.update(std::string_view(buffer.data(),
+                                       static_cast<std::size_t>(bytesRead)));
+    }
+
+    return hasher.digest();
+}
+
+} // namespace data_sync
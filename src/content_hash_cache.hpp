@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sdbusplus/async.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief The structure contains the details to identify the content of
+ *        a file.
+ */
+struct FileState
+{
+    /**
+     * @brief The file size in bytes.
+     */
+    std::uintmax_t _size;
+
+    /**
+     * @brief The last modification time of the file in nanoseconds.
+     */
+    std::int64_t _mtimeInNsec;
+
+    /**
+     * @brief The hash of the file content.
+     */
+    std::uint64_t _hash;
+
+    bool operator==(const FileState&) const = default;
+};
+
+/**
+ * @class ContentHashCache
+ *
+ * @brief This class remembers the content hash of the files at the time of
+ *        their last successful sync to each destination, so that rewriting
+ *        a file with the same content doesn't need a sync.
+ *
+ * @note The cache is persisted, so that a service restart doesn't need to
+ *       sync the unchanged files again. A file synced to one destination
+ *       is still synced to another, e.g. after the sync dest root changes.
+ */
+class ContentHashCache
+{
+  public:
+    /**
+     * @brief The files larger than this size are not hashed and
+     *        always synced.
+     */
+    static constexpr std::uintmax_t maxHashableFileSize = 16 * 1024 * 1024;
+
+    /**
+     * @brief The constructor loads the cache from the given file if exists.
+     *
+     * @param[in] persistFile - The file in which the cache is persisted
+     */
+    explicit ContentHashCache(const fs::path& persistFile);
+
+    /**
+     * @brief Get the current state of the given file, hashing the content
+     *        in a thread to not block the async context.
+     *
+     * @param[in] ctx - The async context to wait for the hashing on
+     * @param[in] path - The file path
+     *
+     * @return The file state; nullopt if the path is not a regular file,
+     *         the file is too large to hash or can't be read.
+     *
+     * @note The content is hashed only if the size or the modification
+     *       time is changed from the cached state.
+     */
+    sdbusplus::async::task<std::optional<FileState>>
+        getFileState(sdbusplus::async::context& ctx,
+                     const fs::path& path) const;
+
+    /**
+     * @brief Get the current state of the given file.
+     *
+     * @param[in] path - The file path
+     *
+     * @return The file state; nullopt if the path is not a regular file,
+     *         the file is too large to hash or can't be read.
+     *
+     * @note The content is hashed in the calling thread, hence the async
+     *       context uses the overload which hashes in a thread.
+     */
+    std::optional<FileState> getFileState(const fs::path& path) const;
+
+    /**
+     * @brief Check whether the given file state matches the state of the
+     *        file at the time of its last successful sync to the given
+     *        destination.
+     *
+     * @param[in] path - The file path
+     * @param[in] dest - The destination of the file
+     * @param[in] fileState - The current state of the file
+     *
+     * @return true if the file content is unchanged since the last sync.
+     */
+    bool isUnchanged(const fs::path& path, const fs::path& dest,
+                     const FileState& fileState) const;
+
+    /**
+     * @brief Record the given file state as the last synced state to the
+     *        given destination.
+     *
+     * @param[in] path - The file path
+     * @param[in] dest - The destination of the file
+     * @param[in] fileState - The state of the synced file
+     */
+    void update(const fs::path& path, const fs::path& dest,
+                const FileState& fileState);
+
+    /**
+     * @brief Forget the given path and all the files under it for all the
+     *        destinations.
+     *
+     * @param[in] path - The file or directory path
+     */
+    void remove(const fs::path& path);
+
+    /**
+     * @brief Write the cache into the persist file if it is modified.
+     *
+     * @return NULL
+     */
+    void persist();
+
+    /**
+     * @brief Check whether the cache has the changes to persist.
+     *
+     * @return true if the cache is modified after the last persist.
+     */
+    bool isDirty() const
+    {
+        return _isDirty;
+    }
+
+    /**
+     * @brief Compute the XXH64 hash of the given data.
+     *
+     * @param[in] data - The data to hash
+     *
+     * @return The hash value.
+     */
+    static std::uint64_t hash(std::string_view data);
+
+    /**
+     * @brief Compute the XXH64 hash of the given file content.
+     *
+     * @param[in] path - The file path
+     *
+     * @return The hash value; nullopt if the file can't be read.
+     */
+    static std::optional<std::uint64_t> hashFile(const fs::path& path);
+
+  private:
+    /**
+     * @brief Get the current state of the given file without hashing its
+     *        content.
+     *
+     * @param[in] path - The file path
+     *
+     * @return The file state along with whether its hash is taken from the
+     *         cache, as the file is not touched since it was cached;
+     *         nullopt if the path is not a regular file or the file is too
+     *         large to hash.
+     */
+    std::optional<std::pair<FileState, bool>>
+        getUnhashedFileState(const fs::path& path) const;
+
+    /**
+     * @brief The file in which the cache is persisted.
+     */
+    fs::path _persistFile;
+
+    /**
+     * @brief The last synced state of the files, per destination of each
+     *        file.
+     */
+    std::unordered_map<std::string, std::unordered_map<std::string, FileState>>
+        _fileStates;
+
+    /**
+     * @brief Whether the cache is modified after the last persist.
+     */
+    bool _isDirty{false};
+};
+
+} // namespace data_sync
@@ -4,9 +4,12 @@
 
 #include "data_sync_config.hpp"
 
+#include "iso_duration.hpp"
+
 #include <phosphor-logging/lg2.hpp>
 
-#include <regex>
+#include <string>
+#include <type_traits>
 
 namespace data_sync::config
 {
@@ -16,20 +19,26 @@ Retry::Retry(uint8_t retryAttempts,
     _retryAttempts(retryAttempts), _retryIntervalInSec(retryIntervalInSec)
 {}
 
-DataSyncConfig::DataSyncConfig(const nlohmann::json& config) :
-    _path(config["Path"].get<std::string>()),
-    _syncDirection(
-        convertSyncDirectionToEnum(config["SyncDirection"].get<std::string>())
-            .value_or(SyncDirection::Active2Passive)),
-    _syncType(convertSyncTypeToEnum(config["SyncType"].get<std::string>())
-                  .value_or(SyncType::Immediate))
+DataSyncConfig::DataSyncConfig(const nlohmann::json& config,
+                               bool isPathDir) :
+    DataSyncConfig(toRawDataSyncConfig(config), isPathDir)
+{}
+
+DataSyncConfig::DataSyncConfig(RawDataSyncConfig rawConfig, bool isPathDir) :
+    _path(std::move(rawConfig._path)), _isPathDir(isPathDir),
+    _syncDirection(convertSyncDirectionToEnum(rawConfig._syncDirection)
+                       .value_or(SyncDirection::Active2Passive)),
+    _syncType(convertSyncTypeToEnum(rawConfig._syncType)
+                  .value_or(SyncType::Immediate)),
+    _excludeFileList(std::move(rawConfig._excludeFileList)),
+    _includeFileList(std::move(rawConfig._includeFileList))
 {
     // Initiailze optional members
     if (_syncType == SyncType::Periodic)
     {
         constexpr auto defPeriodicity = 60;
         _periodicityInSec =
-            convertISODurationToSec(config["Periodicity"].get<std::string>())
+            convertISODurationToSec(rawConfig._periodicity.value_or(""))
                 .value_or(std::chrono::seconds(defPeriodicity));
     }
     else
@@ -37,11 +46,12 @@ DataSyncConfig::DataSyncConfig(const nlohmann::json& config) :
         _periodicityInSec = std::nullopt;
     }
 
-    if (config.contains("RetryAttempts") && config.contains("RetryInterval"))
+    if (rawConfig._retryAttempts.has_value() &&
+        rawConfig._retryInterval.has_value())
     {
         _retry = Retry(
-            config["RetryAttempts"].get<std::uint8_t>(),
-            convertISODurationToSec(config["RetryInterval"].get<std::string>())
+            rawConfig._retryAttempts.value(),
+            convertISODurationToSec(rawConfig._retryInterval.value())
                 .value_or(std::chrono::seconds(DEFAULT_RETRY_INTERVAL)));
     }
     else
@@ -49,25 +59,154 @@ DataSyncConfig::DataSyncConfig(const nlohmann::json& config) :
         _retry = std::nullopt;
     }
 
-    if (config.contains("ExcludeFilesList"))
+    if (rawConfig._quietWindowInMsec.has_value())
     {
-        _excludeFileList =
-            config["ExcludeFilesList"].get<std::vector<std::string>>();
+        _quietWindowInMsec =
+            std::chrono::milliseconds(rawConfig._quietWindowInMsec.value());
     }
     else
     {
-        _excludeFileList = std::nullopt;
+        _quietWindowInMsec = std::nullopt;
+    }
+
+    if (rawConfig._transferMode.has_value())
+    {
+        _transferMode =
+            convertTransferModeToEnum(rawConfig._transferMode.value());
     }
+    else
+    {
+        _transferMode = std::nullopt;
+    }
+
+    _priority = rawConfig._priority.has_value()
+                    ? convertPriorityToEnum(rawConfig._priority.value())
+                          .value_or(Priority::Normal)
+                    : Priority::Normal;
+
+    _bandwidthLimitInKBps = rawConfig._bandwidthLimitInKBps;
 
-    if (config.contains("IncludeFilesList"))
+    if (rawConfig._compression.has_value())
     {
-        _includeFileList =
-            config["IncludeFilesList"].get<std::vector<std::string>>();
+        _compression = convertCompressionToEnum(rawConfig._compression.value());
     }
     else
     {
-        _includeFileList = std::nullopt;
+        _compression = std::nullopt;
+    }
+    _compressionLevel = rawConfig._compressionLevel;
+
+    if (_excludeFileList.has_value())
+    {
+        for (const auto& excludePath : _excludeFileList.value())
+        {
+            _excludeFileTrie.insert(excludePath, excludePath);
+        }
+    }
+
+    if (_includeFileList.has_value())
+    {
+        for (const auto& includePath : _includeFileList.value())
+        {
+            _includeFileTrie.insert(includePath, includePath);
+        }
+    }
+}
+
+bool RawDataSyncConfig::operator==(const RawDataSyncConfig& other) const
+{
+    bool isEqual = true;
+    forEachField([this, &other, &isEqual](const char* /*name*/, auto field) {
+        isEqual = isEqual && this->*field == other.*field;
+    });
+    return isEqual;
+}
+
+RawDataSyncConfig
+    DataSyncConfig::toRawDataSyncConfig(const nlohmann::json& config)
+{
+    RawDataSyncConfig rawConfig;
+    RawDataSyncConfig::forEachField(
+        [&config, &rawConfig](const char* name, auto field) {
+        auto& value = rawConfig.*field;
+        using Value = RawFieldValueT<std::remove_cvref_t<decltype(value)>>;
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>,
+                                     Value>)
+        {
+            // The required property
+            value = config.at(name).template get<Value>();
+        }
+        else if (config.contains(name))
+        {
+            value = config[name].template get<Value>();
+        }
+    });
+    return rawConfig;
+}
+
+bool DataSyncConfig::isPathToSync(const std::filesystem::path& path) const
+{
+    if (_excludeFileTrie.findLongestPrefix(path) != nullptr)
+    {
+        return false;
+    }
+
+    if (_includeFileTrie.empty())
+    {
+        return true;
+    }
+
+    // The parent directories of the included paths are required to reach
+    // the included paths.
+    return _includeFileTrie.findLongestPrefix(path) != nullptr ||
+           _includeFileTrie.hasPatternUnder(path);
+}
+
+RawDataSyncConfig DataSyncConfig::getRawDataSyncConfig() const
+{
+    auto toISODuration = [](const std::chrono::seconds& duration) {
+        return "PT" + std::to_string(duration.count()) + "S";
+    };
+
+    RawDataSyncConfig rawConfig;
+    rawConfig._path = _path;
+    rawConfig._syncDirection = getSyncDirectionInStr();
+    rawConfig._syncType = getSyncTypeInStr();
+    if (_periodicityInSec.has_value())
+    {
+        rawConfig._periodicity = toISODuration(_periodicityInSec.value());
+    }
+    if (_retry.has_value())
+    {
+        rawConfig._retryAttempts = _retry->_retryAttempts;
+        rawConfig._retryInterval = toISODuration(_retry->_retryIntervalInSec);
+    }
+    if (_quietWindowInMsec.has_value())
+    {
+        rawConfig._quietWindowInMsec =
+            static_cast<std::uint32_t>(_quietWindowInMsec->count());
+    }
+    if (_transferMode.has_value())
+    {
+        rawConfig._transferMode = getTransferModeInStr();
+    }
+    rawConfig._priority = getPriorityInStr();
+    rawConfig._bandwidthLimitInKBps = _bandwidthLimitInKBps;
+    if (_compression.has_value())
+    {
+        rawConfig._compression = getCompressionInStr();
     }
+    rawConfig._compressionLevel = _compressionLevel;
+    rawConfig._excludeFileList = _excludeFileList;
+    rawConfig._includeFileList = _includeFileList;
+    return rawConfig;
+}
+
+bool DataSyncConfig::operator==(const DataSyncConfig& other) const
+{
+    // The exclude and include tries are built from the lists.
+    return _isPathDir == other._isPathDir &&
+           getRawDataSyncConfig() == other.getRawDataSyncConfig();
 }
 
 std::optional<SyncDirection>
@@ -112,29 +251,86 @@ std::optional<SyncType>
     }
 }
 
-std::optional<std::chrono::seconds> DataSyncConfig::convertISODurationToSec(
-    const std::string& timeIntervalInISO)
+std::optional<TransferMode>
+    DataSyncConfig::convertTransferModeToEnum(const std::string& transferMode)
 {
-    // TODO: Parse periodicity in ISO 8601 duration format using
-    // std::chrono::parse, as the API is not available in the current gcc
-    // compiler (13.3.0).
-    std::smatch match;
-    std::regex isoDurationRegex("PT(([0-9]+)H)?(([0-9]+)M)?(([0-9]+)S)?");
+    if (transferMode == "Whole")
+    {
+        return TransferMode::Whole;
+    }
+    else if (transferMode == "Delta")
+    {
+        return TransferMode::Delta;
+    }
+    else
+    {
+        lg2::error("Unsupported transfer mode [{TRANSFER_MODE}]",
+                   "TRANSFER_MODE", transferMode);
+        return std::nullopt;
+    }
+}
 
-    if (std::regex_search(timeIntervalInISO, match, isoDurationRegex))
+std::optional<Compression>
+    DataSyncConfig::convertCompressionToEnum(const std::string& compression)
+{
+    if (compression == "None")
+    {
+        return Compression::None;
+    }
+    else if (compression == "LZ4")
+    {
+        return Compression::LZ4;
+    }
+    else if (compression == "Zstd")
     {
-        return (std::chrono::seconds(
-            (match.str(2).empty() ? 0 : (std::stoi(match.str(2)) * 60 * 60)) +
-            (match.str(4).empty() ? 0 : (std::stoi(match.str(4)) * 60)) +
-            (match.str(6).empty() ? 0 : std::stoi(match.str(6)))));
+        return Compression::Zstd;
     }
     else
+    {
+        lg2::error("Unsupported compression [{COMPRESSION}]", "COMPRESSION",
+                   compression);
+        return std::nullopt;
+    }
+}
+
+std::optional<Priority>
+    DataSyncConfig::convertPriorityToEnum(const std::string& priority)
+{
+    if (priority == "High")
+    {
+        return Priority::High;
+    }
+    else if (priority == "Normal")
+    {
+        return Priority::Normal;
+    }
+    else if (priority == "Low")
+    {
+        return Priority::Low;
+    }
+    else
+    {
+        lg2::error("Unsupported sync priority [{PRIORITY}]", "PRIORITY",
+                   priority);
+        return std::nullopt;
+    }
+}
+
+std::optional<std::chrono::seconds> DataSyncConfig::convertISODurationToSec(
+    const std::string& timeIntervalInISO)
+{
+    auto duration = parseISODuration(timeIntervalInISO);
+    if (!duration.has_value())
     {
         lg2::error("{TIME_INTERVAL} is not matching with expected "
-                   "ISO 8601 duration format [PTnHnMnS]",
-                   "TIME_INTERVAL", timeIntervalInISO);
+                   "ISO 8601 duration format [PnDTnHnMnS], error : {ERROR} "
+                   "at position {POSITION}",
+                   "TIME_INTERVAL", timeIntervalInISO, "ERROR",
+                   duration.error()._reason, "POSITION",
+                   duration.error()._position);
         return std::nullopt;
     }
+    return duration.value();
 }
 
 } // namespace data_sync::config
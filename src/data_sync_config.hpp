@@ -2,12 +2,17 @@
 
 #pragma once
 
+#include "path_trie.hpp"
+
 #include <nlohmann/json.hpp>
 
 #include <chrono>
+#include <cstdint>
+#include <filesystem>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace data_sync::config
 {
@@ -15,7 +20,7 @@ namespace data_sync::config
 /**
  * @brief The enum contains all the sync directions.
  */
-enum class SyncDirection
+enum class SyncDirection : std::uint8_t
 {
     Active2Passive,
     Passive2Active,
@@ -25,12 +30,42 @@ enum class SyncDirection
 /**
  * @brief The enum contains all the sync types.
  */
-enum class SyncType
+enum class SyncType : std::uint8_t
 {
     Immediate,
     Periodic
 };
 
+/**
+ * @brief The enum contains all the transfer modes.
+ */
+enum class TransferMode : std::uint8_t
+{
+    Whole,
+    Delta
+};
+
+/**
+ * @brief The enum contains all the compressions of the transfer.
+ */
+enum class Compression : std::uint8_t
+{
+    None,
+    LZ4,
+    Zstd
+};
+
+/**
+ * @brief The enum contains all the sync priorities, in the order from the
+ *        highest to the lowest priority.
+ */
+enum class Priority : std::uint8_t
+{
+    High,
+    Normal,
+    Low
+};
+
 /**
  * @brief The structure contains all retry-related details
  *        specific to a file or directory to retry if failed to sync.
@@ -56,6 +91,93 @@ struct Retry
      * @brief Retry interval in seconds
      */
     std::chrono::seconds _retryIntervalInSec;
+
+    bool operator==(const Retry&) const = default;
+};
+
+/**
+ * @brief The type of the value of a field of the raw data sync config,
+ *        which is held in a std::optional if the property is optional.
+ */
+template <typename T>
+struct RawFieldValue
+{
+    using type = T;
+};
+
+template <typename T>
+struct RawFieldValue<std::optional<T>>
+{
+    using type = T;
+};
+
+template <typename T>
+using RawFieldValueT = typename RawFieldValue<T>::type;
+
+/**
+ * @brief The structure contains the values of a file or directory as
+ *        specified in the configuration file, before validating them.
+ *
+ * @note The optional members hold a value if the respective property is
+ *       specified in the configuration file.
+ */
+struct RawDataSyncConfig
+{
+    /**
+     * @brief Call the given function with the name of each property of the
+     *        configuration and the member which holds its value.
+     *
+     * @param[in] func - The function to call as func(name, member)
+     *
+     * @note This is the only list of the properties, from which the
+     *       parsers, the comparison and the snapshot of the config are
+     *       built, hence a new property is to be added only here. The
+     *       order is the order of the fields in the snapshot.
+     */
+    template <typename Func>
+    static constexpr void forEachField(Func&& func)
+    {
+        func("Path", &RawDataSyncConfig::_path);
+        func("SyncDirection", &RawDataSyncConfig::_syncDirection);
+        func("SyncType", &RawDataSyncConfig::_syncType);
+        func("Periodicity", &RawDataSyncConfig::_periodicity);
+        func("RetryAttempts", &RawDataSyncConfig::_retryAttempts);
+        func("RetryInterval", &RawDataSyncConfig::_retryInterval);
+        func("QuietWindowInMsec", &RawDataSyncConfig::_quietWindowInMsec);
+        func("TransferMode", &RawDataSyncConfig::_transferMode);
+        func("Priority", &RawDataSyncConfig::_priority);
+        func("BandwidthLimitInKBps",
+             &RawDataSyncConfig::_bandwidthLimitInKBps);
+        func("Compression", &RawDataSyncConfig::_compression);
+        func("CompressionLevel", &RawDataSyncConfig::_compressionLevel);
+        func("ExcludeFilesList", &RawDataSyncConfig::_excludeFileList);
+        func("IncludeFilesList", &RawDataSyncConfig::_includeFileList);
+    }
+
+    /**
+     * @brief Check whether the given raw data sync config has the same
+     *        values as this one.
+     *
+     * @param[in] other - The raw data sync config to compare with
+     *
+     * @return true if all the properties have the same values.
+     */
+    bool operator==(const RawDataSyncConfig& other) const;
+
+    std::string _path;
+    std::string _syncDirection;
+    std::string _syncType;
+    std::optional<std::string> _periodicity;
+    std::optional<std::uint8_t> _retryAttempts;
+    std::optional<std::string> _retryInterval;
+    std::optional<std::uint32_t> _quietWindowInMsec;
+    std::optional<std::string> _transferMode;
+    std::optional<std::string> _priority;
+    std::optional<std::uint32_t> _bandwidthLimitInKBps;
+    std::optional<std::string> _compression;
+    std::optional<std::uint8_t> _compressionLevel;
+    std::optional<std::vector<std::string>> _excludeFileList;
+    std::optional<std::vector<std::string>> _includeFileList;
 };
 
 /**
@@ -70,8 +192,18 @@ struct DataSyncConfig
      * @brief The constructor initializes members using the configuration.
      *
      * @param[in] config - The sync data information
+     * @param[in] isPathDir - Whether the configured path is a directory
      */
-    DataSyncConfig(const nlohmann::json& config);
+    DataSyncConfig(const nlohmann::json& config, bool isPathDir);
+
+    /**
+     * @brief The constructor initializes members using the values read
+     *        from the configuration.
+     *
+     * @param[in] rawConfig - The sync data information
+     * @param[in] isPathDir - Whether the configured path is a directory
+     */
+    DataSyncConfig(RawDataSyncConfig rawConfig, bool isPathDir);
 
     /**
      * @brief Get sync direction in string format.
@@ -109,11 +241,115 @@ struct DataSyncConfig
         return "";
     }
 
+    /**
+     * @brief Get transfer mode in string format.
+     *
+     * @return The transfer mode in string
+     */
+    constexpr std::string_view getTransferModeInStr() const
+    {
+        if (!_transferMode.has_value())
+        {
+            return "";
+        }
+        switch (_transferMode.value())
+        {
+            case TransferMode::Whole:
+                return "Whole";
+            case TransferMode::Delta:
+                return "Delta";
+        }
+        return "";
+    }
+
+    /**
+     * @brief Get compression in string format.
+     *
+     * @return The compression in string
+     */
+    constexpr std::string_view getCompressionInStr() const
+    {
+        if (!_compression.has_value())
+        {
+            return "";
+        }
+        switch (_compression.value())
+        {
+            case Compression::None:
+                return "None";
+            case Compression::LZ4:
+                return "LZ4";
+            case Compression::Zstd:
+                return "Zstd";
+        }
+        return "";
+    }
+
+    /**
+     * @brief Get sync priority in string format.
+     *
+     * @return The sync priority in string
+     */
+    constexpr std::string_view getPriorityInStr() const
+    {
+        switch (_priority)
+        {
+            case Priority::High:
+                return "High";
+            case Priority::Normal:
+                return "Normal";
+            case Priority::Low:
+                return "Low";
+        }
+        return "";
+    }
+
+    /**
+     * @brief Check whether the given path under the configured directory
+     *        has to be synchronized as per the exclude and include lists.
+     *
+     * @param[in] path - The path to check
+     *
+     * @return true if the path is not excluded and is either included or
+     *         a parent directory of an included path.
+     *
+     * @note The lookup cost depends only on the depth of the given path
+     *       and not on the length of the lists.
+     */
+    bool isPathToSync(const std::filesystem::path& path) const;
+
+    /**
+     * @brief Get the values of this data sync config in the form of the
+     *        configuration file.
+     *
+     * @return The values of the data sync config, from which the same
+     *         data sync config is built.
+     */
+    RawDataSyncConfig getRawDataSyncConfig() const;
+
+    /**
+     * @brief Check whether the given data sync config has the same values
+     *        as this one.
+     *
+     * @param[in] other - The data sync config to compare with
+     *
+     * @return true if all the configured values are the same.
+     *
+     * @note The values are compared in the form of the configuration file,
+     *       hence all the properties of the field table are compared.
+     */
+    bool operator==(const DataSyncConfig& other) const;
+
     /**
      * @brief The file or directory path to be synchronized.
      */
     std::string _path;
 
+    /**
+     * @brief Used to identify whether the configured path is a directory.
+     */
+    bool _isPathDir;
+
     /**
      * @brief Used to get sync direction.
      */
@@ -139,6 +375,59 @@ struct DataSyncConfig
      */
     std::optional<Retry> _retry;
 
+    /**
+     * @brief The time (in milliseconds) without further changes to wait
+     *        before syncing a burst of changes as a single sync.
+     *
+     * @note Holds a value if the specific file or directory uses
+     *       a custom quiet window.
+     */
+    std::optional<std::chrono::milliseconds> _quietWindowInMsec;
+
+    /**
+     * @brief Used to get transfer mode.
+     *
+     * @note Holds a value if the specific file or directory prefers to
+     *       either transfer the whole file or only the changed blocks of
+     *       the file instead of the default behavior of the sync tool.
+     */
+    std::optional<TransferMode> _transferMode;
+
+    /**
+     * @brief Used to get the sync priority.
+     *
+     * @note The data with a higher priority is synced ahead of the data
+     *       with a lower priority, and may interrupt the ongoing sync of
+     *       the lower priority data.
+     */
+    Priority _priority;
+
+    /**
+     * @brief The maximum bandwidth (in KiB per second) to use to sync the
+     *        data, where zero indicates no limit.
+     *
+     * @note Holds a value if the specific file or directory uses
+     *       a custom bandwidth limit.
+     */
+    std::optional<std::uint32_t> _bandwidthLimitInKBps;
+
+    /**
+     * @brief Used to get the compression of the transfer.
+     *
+     * @note Holds a value if the specific file or directory prefers to
+     *       compress the data while transferring, which is worth for the
+     *       data that compresses well such as text.
+     */
+    std::optional<Compression> _compression;
+
+    /**
+     * @brief The level of the Zstd compression.
+     *
+     * @note Holds a value if the specific file or directory uses a custom
+     *       compression level instead of the default level of the codec.
+     */
+    std::optional<std::uint8_t> _compressionLevel;
+
     /**
      * @brief The list of paths to exclude from synchronization.
      *
@@ -155,7 +444,30 @@ struct DataSyncConfig
      */
     std::optional<std::vector<std::string>> _includeFileList;
 
+    /**
+     * @brief The exclude list compiled for the lookup of the paths.
+     *
+     * @note The value of each pattern is the configured exclude path.
+     */
+    PathTrie<std::string> _excludeFileTrie;
+
+    /**
+     * @brief The include list compiled for the lookup of the paths.
+     *
+     * @note The value of each pattern is the configured include path.
+     */
+    PathTrie<std::string> _includeFileTrie;
+
   private:
+    /**
+     * @brief A helper API to get the values of the given configuration.
+     *
+     * @param[in] config - The sync data information
+     *
+     * @returns The values of the configuration.
+     */
+    static RawDataSyncConfig toRawDataSyncConfig(const nlohmann::json& config);
+
     /**
      * @brief A helper API to retrieve the corresponding enum type
      *        for a given sync direction string.
@@ -178,6 +490,39 @@ struct DataSyncConfig
     static std::optional<SyncType>
         convertSyncTypeToEnum(const std::string& syncType);
 
+    /**
+     * @brief A helper API to retrieve the corresponding enum type
+     *        for a given transfer mode string.
+     *
+     * @param[in] - transferMode - the transfer mode
+     *
+     * @returns The enum value on success; otherwise, nullopt.
+     */
+    static std::optional<TransferMode>
+        convertTransferModeToEnum(const std::string& transferMode);
+
+    /**
+     * @brief A helper API to retrieve the corresponding enum type
+     *        for a given compression string.
+     *
+     * @param[in] - compression - the compression
+     *
+     * @returns The enum value on success; otherwise, nullopt.
+     */
+    static std::optional<Compression>
+        convertCompressionToEnum(const std::string& compression);
+
+    /**
+     * @brief A helper API to retrieve the corresponding enum type
+     *        for a given sync priority string.
+     *
+     * @param[in] - priority - the sync priority
+     *
+     * @returns The enum value on success; otherwise, nullopt.
+     */
+    static std::optional<Priority>
+        convertPriorityToEnum(const std::string& priority);
+
     /**
      * @brief A helper API to convert the time duration in ISO 8601 duration
      *        format into seconds
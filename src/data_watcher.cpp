@@ -0,0 +1,271 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "data_watcher.hpp"
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+namespace data_sync::watch::inotify
+{
+
+namespace
+{
+
+/**
+ * @brief A helper API to check whether the given base path is the same as
+ *        or a parent of the given path.
+ *
+ * @param[in] base - The base path
+ * @param[in] path - The path to check
+ *
+ * @return true if the path is the base path or present under it.
+ */
+bool isSameOrUnder(const fs::path& base, const fs::path& path)
+{
+    auto [baseIt, pathIt] =
+        std::mismatch(base.begin(), base.end(), path.begin(), path.end());
+    return baseIt == base.end();
+}
+
+} // namespace
+
+DataWatcher::DataWatcher(sdbusplus::async::context& ctx, int inotifyFlags,
+                         uint32_t eventMasksToWatch,
+                         const fs::path& dataPathToWatch,
+                         PathFilter pathFilter) :
+    _ctx(ctx), _eventMasksToWatch(eventMasksToWatch),
+    _dataPathToWatch(dataPathToWatch), _pathFilter(std::move(pathFilter)),
+    // The events are read till EAGAIN, hence always use the non-blocking mode
+    _inotifyFD(inotify_init1(inotifyFlags | IN_NONBLOCK))
+{
+    if (_inotifyFD() == -1)
+    {
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to initialize inotify for " +
+                                    _dataPathToWatch.string());
+    }
+
+    armWatch();
+
+    _fdioInstance = std::make_unique<sdbusplus::async::fdio>(_ctx,
+                                                             _inotifyFD());
+}
+
+DataWatcher::~DataWatcher()
+{
+    // The fdio instance has to be released before closing the fd.
+    _fdioInstance.reset();
+    removeAllWatches();
+}
+
+void DataWatcher::armWatch()
+{
+    std::error_code ec;
+    if (fs::is_directory(_dataPathToWatch, ec))
+    {
+        addToWatchList(_dataPathToWatch, true);
+        return;
+    }
+
+    // Files are watched through the parent directory to catch the
+    // replacement by rename, and the not yet created paths through the
+    // nearest existing parent directory to catch the creation.
+    auto parentPath = _dataPathToWatch.parent_path();
+    while (parentPath != parentPath.root_path() &&
+           !fs::is_directory(parentPath, ec))
+    {
+        parentPath = parentPath.parent_path();
+    }
+    addToWatchList(parentPath, false);
+}
+
+void DataWatcher::addToWatchList(const fs::path& pathToWatch, bool recursive)
+{
+    auto wd = inotify_add_watch(_inotifyFD(), pathToWatch.c_str(),
+                                _eventMasksToWatch);
+    if (wd == -1)
+    {
+        lg2::error("Failed to add watch for [{PATH}], errno : {ERRNO}",
+                   "PATH", pathToWatch, "ERRNO", errno);
+        return;
+    }
+    _watchDescriptors.insert_or_assign(wd, pathToWatch);
+
+    if (!recursive)
+    {
+        return;
+    }
+
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(
+             pathToWatch, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (it->is_directory(ec) && !it->is_symlink(ec))
+        {
+            if (!isPathOfInterest(it->path()))
+            {
+                // Nothing to sync under it, hence don't spend the watches.
+                it.disable_recursion_pending();
+                continue;
+            }
+
+            auto subDirWD = inotify_add_watch(
+                _inotifyFD(), it->path().c_str(), _eventMasksToWatch);
+            if (subDirWD == -1)
+            {
+                lg2::error("Failed to add watch for [{PATH}], errno : {ERRNO}",
+                           "PATH", it->path(), "ERRNO", errno);
+                continue;
+            }
+            _watchDescriptors.insert_or_assign(subDirWD, it->path());
+        }
+    }
+}
+
+void DataWatcher::removeAllWatches()
+{
+    std::ranges::for_each(_watchDescriptors, [this](const auto& watch) {
+        inotify_rm_watch(_inotifyFD(), watch.first);
+    });
+    _watchDescriptors.clear();
+}
+
+bool DataWatcher::isUnderWatchedPath(const fs::path& path) const
+{
+    return isSameOrUnder(_dataPathToWatch, path);
+}
+
+bool DataWatcher::isPathOfInterest(const fs::path& path) const
+{
+    return !_pathFilter || _pathFilter(path);
+}
+
+sdbusplus::async::task<std::vector<fs::path>> DataWatcher::onDataChange()
+{
+    co_await _fdioInstance->next();
+
+    std::vector<fs::path> changedPaths;
+    _rearmRequired = false;
+
+    while (true)
+    {
+        auto bytesRead = read(_inotifyFD(), _eventBuffer.data(),
+                              _eventBuffer.size());
+        if (bytesRead <= 0)
+        {
+            if (bytesRead == -1 && errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for (auto offset = 0; offset < bytesRead;)
+        {
+            const auto* event =
+                reinterpret_cast<const inotify_event*>(&_eventBuffer[offset]);
+            processEvent(*event, changedPaths);
+            offset += static_cast<int>(sizeof(inotify_event) + event->len);
+        }
+    }
+
+    if (_rearmRequired)
+    {
+        removeAllWatches();
+        armWatch();
+
+        std::error_code ec;
+        if (fs::exists(_dataPathToWatch, ec))
+        {
+            changedPaths.emplace_back(_dataPathToWatch);
+        }
+    }
+
+    co_return changedPaths;
+}
+
+void DataWatcher::processEvent(const inotify_event& event,
+                               std::vector<fs::path>& changedPaths)
+{
+    if ((event.mask & IN_Q_OVERFLOW) != 0)
+    {
+        // Some events are lost, hence consider the whole path as changed.
+        lg2::warning("The inotify event queue overflowed for [{PATH}]", "PATH",
+                     _dataPathToWatch);
+        changedPaths.emplace_back(_dataPathToWatch);
+        return;
+    }
+
+    auto watchIt = _watchDescriptors.find(event.wd);
+    if (watchIt == _watchDescriptors.end())
+    {
+        return;
+    }
+
+    if ((event.mask & IN_IGNORED) != 0)
+    {
+        // The watched path is removed. Re-arm if the configured path itself
+        // or the parent directory being watched for it is removed.
+        if (watchIt->second == _dataPathToWatch ||
+            !isUnderWatchedPath(watchIt->second))
+        {
+            _rearmRequired = true;
+        }
+        _watchDescriptors.erase(watchIt);
+        return;
+    }
+
+    const auto eventPath = event.len > 0 ? watchIt->second / event.name
+                                         : watchIt->second;
+    const bool isDir = (event.mask & IN_ISDIR) != 0;
+    const bool isCreated = (event.mask & (IN_CREATE | IN_MOVED_TO)) != 0;
+
+    if (isUnderWatchedPath(eventPath))
+    {
+        if (eventPath != _dataPathToWatch && !isPathOfInterest(eventPath))
+        {
+            return;
+        }
+
+        if (eventPath == _dataPathToWatch)
+        {
+            // The configured directory got created or moved, hence watch
+            // it (recursively) from its new state.
+            if ((isCreated && isDir) || (event.mask & IN_MOVE_SELF) != 0)
+            {
+                _rearmRequired = true;
+            }
+        }
+        else if (isDir && isCreated)
+        {
+            addToWatchList(eventPath, true);
+        }
+        else if (isDir && (event.mask & IN_MOVED_FROM) != 0)
+        {
+            // Drop the stale watches, they will be added again with the
+            // new path if the directory is moved within the watched path.
+            std::erase_if(_watchDescriptors, [this, &eventPath](auto& watch) {
+                if (isSameOrUnder(eventPath, watch.second))
+                {
+                    inotify_rm_watch(_inotifyFD(), watch.first);
+                    return true;
+                }
+                return false;
+            });
+        }
+        changedPaths.emplace_back(eventPath);
+    }
+    else if (isDir && isCreated && isSameOrUnder(eventPath, _dataPathToWatch))
+    {
+        // A missing parent directory of the configured path got created,
+        // hence move the watch closer.
+        _rearmRequired = true;
+    }
+}
+
+} // namespace data_sync::watch::inotify
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "utility.hpp"
+
+#include <sys/inotify.h>
+
+#include <sdbusplus/async.hpp>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace data_sync::watch::inotify
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief The inotify events which are of interest to sync the data.
+ */
+constexpr uint32_t defaultEventMasks = IN_CLOSE_WRITE | IN_MOVED_TO |
+                                       IN_MOVED_FROM | IN_CREATE | IN_DELETE |
+                                       IN_DELETE_SELF | IN_MOVE_SELF;
+
+/**
+ * @brief The callable to decide whether the changes of the given path are
+ *        of interest.
+ */
+using PathFilter = std::function<bool(const fs::path&)>;
+
+/**
+ * @class DataWatcher
+ *
+ * @brief This class monitors the configured file or directory for changes
+ *        using inotify and notifies the changed paths through the async
+ *        context.
+ *
+ * @note A directory is monitored recursively and sub directories created
+ *       later are added to the watch list on the fly. A file is monitored
+ *       through its parent directory so that the file replaced by rename
+ *       is also detected. If the configured path doesn't exist yet, the
+ *       nearest existing parent directory is monitored until the path gets
+ *       created.
+ */
+class DataWatcher
+{
+  public:
+    DataWatcher(const DataWatcher&) = delete;
+    DataWatcher& operator=(const DataWatcher&) = delete;
+    DataWatcher(DataWatcher&&) = delete;
+    DataWatcher& operator=(DataWatcher&&) = delete;
+    ~DataWatcher();
+
+    /**
+     * @brief The constructor initializes the inotify instance and adds the
+     *        configured path into the watch list.
+     *
+     * @param[in] ctx - The async context to wait for the inotify events on
+     * @param[in] inotifyFlags - The flags to initialize the inotify instance
+     * @param[in] eventMasksToWatch - The inotify events to watch
+     * @param[in] dataPathToWatch - The file or directory path to watch
+     * @param[in] pathFilter - The filter to skip the paths under the
+     *                         configured directory which are not of interest,
+     *                         such as the excluded files and directories.
+     *                         All paths are of interest if not given.
+     *
+     * @throw std::system_error if the inotify instance can't be created.
+     */
+    DataWatcher(sdbusplus::async::context& ctx, int inotifyFlags,
+                uint32_t eventMasksToWatch, const fs::path& dataPathToWatch,
+                PathFilter pathFilter = {});
+
+    /**
+     * @brief Wait for the changes in the configured path.
+     *
+     * @return The list of changed paths which belongs to the configured path.
+     *         The list may be empty if the received events didn't affect
+     *         the configured path.
+     */
+    sdbusplus::async::task<std::vector<fs::path>> onDataChange();
+
+  private:
+    /**
+     * @brief A helper API to add the configured path (or its nearest
+     *        existing parent) into the watch list.
+     */
+    void armWatch();
+
+    /**
+     * @brief A helper API to add the given path into the inotify watch list.
+     *
+     * @param[in] pathToWatch - The path to watch
+     * @param[in] recursive - Whether to watch the sub directories as well
+     */
+    void addToWatchList(const fs::path& pathToWatch, bool recursive);
+
+    /**
+     * @brief A helper API to remove all watches from the inotify instance.
+     */
+    void removeAllWatches();
+
+    /**
+     * @brief A helper API to process the given inotify event.
+     *
+     * @param[in] event - The inotify event
+     * @param[out] changedPaths - The list to add the changed path into
+     */
+    void processEvent(const inotify_event& event,
+                      std::vector<fs::path>& changedPaths);
+
+    /**
+     * @brief A helper API to check whether the given path is the configured
+     *        path or is present under the configured path.
+     *
+     * @param[in] path - The path to check
+     *
+     * @return true if the path belongs to the configured path.
+     */
+    bool isUnderWatchedPath(const fs::path& path) const;
+
+    /**
+     * @brief A helper API to check whether the given path under the
+     *        configured path is of interest as per the path filter.
+     *
+     * @param[in] path - The path to check
+     *
+     * @return true if the path is of interest.
+     */
+    bool isPathOfInterest(const fs::path& path) const;
+
+    /**
+     * @brief The async context.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The inotify events to watch.
+     */
+    uint32_t _eventMasksToWatch;
+
+    /**
+     * @brief The configured file or directory path to watch.
+     */
+    fs::path _dataPathToWatch;
+
+    /**
+     * @brief The filter to skip the paths which are not of interest.
+     */
+    PathFilter _pathFilter;
+
+    /**
+     * @brief The inotify file descriptor.
+     */
+    utility::FD _inotifyFD;
+
+    /**
+     * @brief The watch descriptors and the corresponding watched paths.
+     */
+    std::map<int, fs::path> _watchDescriptors;
+
+    /**
+     * @brief Whether the watch list needs to be rebuilt after processing
+     *        the current set of events.
+     */
+    bool _rearmRequired{false};
+
+    /**
+     * @brief The fdio instance to wait for the inotify events
+     *        through the async context.
+     */
+    std::unique_ptr<sdbusplus::async::fdio> _fdioInstance;
+
+    /**
+     * @brief The buffer to read the inotify events into.
+     *
+     * @note It is kept along with the watcher rather than in the frame of
+     *       onDataChange(), which is allocated on every wait.
+     */
+    alignas(inotify_event) std::array<char, 4096> _eventBuffer{};
+};
+
+} // namespace data_sync::watch::inotify
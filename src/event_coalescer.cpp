@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "event_coalescer.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace data_sync
+{
+
+bool EventCoalescer::addEvents(const std::string& key,
+                               const std::vector<fs::path>& changedPaths,
+                               Clock::time_point now)
+{
+    auto [pendingIt, isNew] = _pendingEvents.try_emplace(key);
+    auto& pending = pendingIt->second;
+
+    if (pending._eventsCount == 0)
+    {
+        pending._firstEventTime = now;
+    }
+    pending._lastEventTime = now;
+    pending._eventsCount++;
+
+    // Too many changed paths, just sync the whole configured path.
+    if (pending._changedPaths.size() + changedPaths.size() > maxChangedPaths)
+    {
+        pending._changedPaths = {fs::path(key)};
+    }
+    else if (!pending._changedPaths.contains(fs::path(key)))
+    {
+        pending._changedPaths.insert(changedPaths.begin(), changedPaths.end());
+    }
+
+    return isNew;
+}
+
+std::optional<EventCoalescer::Clock::duration> EventCoalescer::timeToSettle(
+    const std::string& key, Clock::duration quietWindow,
+    Clock::duration maxLatency, Clock::time_point now)
+{
+    auto pendingIt = _pendingEvents.find(key);
+    if (pendingIt == _pendingEvents.end())
+    {
+        return std::nullopt;
+    }
+
+    if (pendingIt->second._eventsCount == 0)
+    {
+        _pendingEvents.erase(pendingIt);
+        return std::nullopt;
+    }
+
+    const auto& pending = pendingIt->second;
+    const auto settleTime = std::min(pending._lastEventTime + quietWindow,
+                                     pending._firstEventTime + maxLatency);
+    return settleTime > now ? settleTime - now : Clock::duration::zero();
+}
+
+std::optional<EventCoalescer::Clock::time_point>
+    EventCoalescer::getFirstEventTime(const std::string& key) const
+{
+    const auto pendingIt = _pendingEvents.find(key);
+    if (pendingIt == _pendingEvents.end() ||
+        pendingIt->second._eventsCount == 0)
+    {
+        return std::nullopt;
+    }
+    return pendingIt->second._firstEventTime;
+}
+
+std::set<fs::path> EventCoalescer::takeEvents(const std::string& key)
+{
+    auto pendingIt = _pendingEvents.find(key);
+    if (pendingIt == _pendingEvents.end())
+    {
+        return {};
+    }
+
+    auto& pending = pendingIt->second;
+    if (pending._eventsCount > 1)
+    {
+        _coalescedEventsCount += pending._eventsCount - 1;
+    }
+    pending._eventsCount = 0;
+
+    return std::exchange(pending._changedPaths, {});
+}
+
+} // namespace data_sync
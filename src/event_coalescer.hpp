@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class EventCoalescer
+ *
+ * @brief This class collapses a burst of change events of a configured path
+ *        into a single sync once the path is quiet for the given window.
+ *
+ * @note The pending events are keyed on the configured path (i.e.
+ *       DataSyncConfig::_path) and an entry exists as long as someone is
+ *       draining the events of that path, so that only one sync is in
+ *       progress for a path at any time.
+ */
+class EventCoalescer
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The maximum number of changed paths to track per configured
+     *        path, beyond which the configured path itself is considered
+     *        as changed.
+     */
+    static constexpr std::size_t maxChangedPaths = 256;
+
+    /**
+     * @brief Record the change events of the given configured path.
+     *
+     * @param[in] key - The configured path
+     * @param[in] changedPaths - The paths changed under the configured path
+     * @param[in] now - The time at which the events are received
+     *
+     * @return true if the events of the given path are not being drained
+     *         already, so the caller needs to start draining; false otherwise.
+     */
+    bool addEvents(const std::string& key,
+                   const std::vector<fs::path>& changedPaths,
+                   Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Get the remaining time for the given configured path to be
+     *        quiet for the given window, or for its first pending event to
+     *        reach the given maximum latency.
+     *
+     * @param[in] key - The configured path
+     * @param[in] quietWindow - The time without events to consider the
+     *                          burst as finished
+     * @param[in] maxLatency - The maximum time to hold the first pending
+     *                         event, after which the burst is flushed even
+     *                         if the path is not quiet
+     * @param[in] now - The current time
+     *
+     * @return The remaining time (zero if the path is already settled);
+     *         nullopt if no events are pending, and the draining is
+     *         considered as finished.
+     *
+     * @note The maximum latency keeps a path which changes more often than
+     *       the quiet window from pushing its sync back forever.
+     */
+    std::optional<Clock::duration>
+        timeToSettle(const std::string& key, Clock::duration quietWindow,
+                     Clock::duration maxLatency,
+                     Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Get the time at which the first event since the last take is
+     *        received for the given configured path.
+     *
+     * @param[in] key - The configured path
+     *
+     * @return The time of the first event; nullopt if no events are pending.
+     */
+    std::optional<Clock::time_point>
+        getFirstEventTime(const std::string& key) const;
+
+    /**
+     * @brief Take the pending changed paths of the given configured path.
+     *
+     * @param[in] key - The configured path
+     *
+     * @return The changed paths which are collected since the last take.
+     */
+    std::set<fs::path> takeEvents(const std::string& key);
+
+    /**
+     * @brief Get the number of events which didn't need a separate sync.
+     *
+     * @return The coalesced events count.
+     */
+    std::size_t getCoalescedEventsCount() const
+    {
+        return _coalescedEventsCount;
+    }
+
+  private:
+    /**
+     * @brief The events pending to be synced for a configured path.
+     */
+    struct PendingEvents
+    {
+        /**
+         * @brief The time at which the first event since the last take is
+         *        received.
+         */
+        Clock::time_point _firstEventTime;
+
+        /**
+         * @brief The time at which the last event is received.
+         */
+        Clock::time_point _lastEventTime;
+
+        /**
+         * @brief The number of events received since the last take.
+         */
+        std::size_t _eventsCount{0};
+
+        /**
+         * @brief The paths changed since the last take.
+         */
+        std::set<fs::path> _changedPaths;
+    };
+
+    /**
+     * @brief The pending events of the configured paths being drained.
+     */
+    std::map<std::string, PendingEvents> _pendingEvents;
+
+    /**
+     * @brief The number of events which are collapsed with another event.
+     */
+    std::size_t _coalescedEventsCount{0};
+};
+
+} // namespace data_sync
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <string_view>
+
+namespace data_sync::config
+{
+
+/**
+ * @brief The details of the failure to parse an ISO 8601 duration.
+ */
+struct ISODurationError
+{
+    /**
+     * @brief The reason of the failure.
+     */
+    std::string_view _reason;
+
+    /**
+     * @brief The position of the character where the parsing failed.
+     */
+    std::size_t _position;
+};
+
+/**
+ * @brief Parse the given time duration in ISO 8601 duration format
+ *        [PnDTnHnMnS] into seconds.
+ *
+ * @param[in] duration - The time duration, e.g. "P1DT2H", "PT1M10S"
+ *
+ * @return The time duration in seconds on success; otherwise, the reason
+ *         and the position of the failure.
+ *
+ * @note The units are optional but have to be in the above order and at
+ *       least one unit must be present. The year, month, week and
+ *       fractional values are not supported.
+ */
+constexpr std::expected<std::chrono::seconds, ISODurationError>
+    parseISODuration(std::string_view duration)
+{
+    using Seconds = std::chrono::seconds::rep;
+
+    struct Unit
+    {
+        char _designator;
+        Seconds _secondsPerUnit;
+        bool _isTimeUnit;
+    };
+    constexpr std::array<Unit, 4> units{{{'D', 24 * 60 * 60, false},
+                                         {'H', 60 * 60, true},
+                                         {'M', 60, true},
+                                         {'S', 1, true}}};
+
+    if (duration.empty() || duration.front() != 'P')
+    {
+        return std::unexpected(
+            ISODurationError{"The duration must start with 'P'", 0});
+    }
+
+    Seconds totalSeconds{0};
+    std::size_t position{1};
+    std::size_t nextUnit{0};
+    bool isTimePart{false};
+    bool hasAnyUnit{false};
+    bool hasTimeUnit{false};
+
+    while (position < duration.size())
+    {
+        if (duration[position] == 'T')
+        {
+            if (isTimePart)
+            {
+                return std::unexpected(ISODurationError{
+                    "Duplicate time designator 'T'", position});
+            }
+            isTimePart = true;
+            ++position;
+            continue;
+        }
+
+        const auto numberStart = position;
+        Seconds value{0};
+        while (position < duration.size() && duration[position] >= '0' &&
+               duration[position] <= '9')
+        {
+            const auto digit = duration[position] - '0';
+            if (value > (std::numeric_limits<Seconds>::max() - digit) / 10)
+            {
+                return std::unexpected(
+                    ISODurationError{"The value is too large", numberStart});
+            }
+            value = (value * 10) + digit;
+            ++position;
+        }
+        if (position == numberStart)
+        {
+            return std::unexpected(
+                ISODurationError{"Expected a number", position});
+        }
+        if (position == duration.size())
+        {
+            return std::unexpected(
+                ISODurationError{"Missing the unit designator", position});
+        }
+
+        // The 'M' designator is the month in the date part, which is not
+        // supported, hence look up the units of the current part only.
+        const auto designator = duration[position];
+        auto unitIndex = nextUnit;
+        while (unitIndex < units.size() &&
+               (units[unitIndex]._designator != designator ||
+                units[unitIndex]._isTimeUnit != isTimePart))
+        {
+            ++unitIndex;
+        }
+        if (unitIndex == units.size())
+        {
+            return std::unexpected(ISODurationError{
+                "Unsupported or out of order unit designator", position});
+        }
+
+        const auto secondsPerUnit = units[unitIndex]._secondsPerUnit;
+        if (value > (std::numeric_limits<Seconds>::max() - totalSeconds) /
+                        secondsPerUnit)
+        {
+            return std::unexpected(
+                ISODurationError{"The duration is too large", numberStart});
+        }
+        totalSeconds += value * secondsPerUnit;
+
+        nextUnit = unitIndex + 1;
+        hasAnyUnit = true;
+        hasTimeUnit |= isTimePart;
+        ++position;
+    }
+
+    if (isTimePart && !hasTimeUnit)
+    {
+        return std::unexpected(ISODurationError{
+            "Missing the time units after 'T'", duration.size()});
+    }
+    if (!hasAnyUnit)
+    {
+        return std::unexpected(
+            ISODurationError{"Missing the duration units", duration.size()});
+    }
+
+    return std::chrono::seconds(totalSeconds);
+}
+
+} // namespace data_sync::config
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "latency_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace data_sync
+{
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration latency)
+{
+    _counts[getBucket(latency)]++;
+    _totalCount++;
+}
+
+std::chrono::microseconds
+    LatencyHistogram::getPercentile(double percentile) const
+{
+    if (_totalCount == 0)
+    {
+        return std::chrono::microseconds::zero();
+    }
+
+    const auto rank = static_cast<std::uint64_t>(std::ceil(
+        std::clamp(percentile, 0.0, 100.0) / 100.0 *
+        static_cast<double>(_totalCount)));
+    std::uint64_t count = 0;
+    std::size_t bucket = 0;
+    for (; bucket < bucketsCount - 1; ++bucket)
+    {
+        count += _counts[bucket];
+        if (count >= std::max<std::uint64_t>(rank, 1))
+        {
+            break;
+        }
+    }
+    return std::chrono::microseconds(std::uint64_t{1} << bucket);
+}
+
+std::size_t
+    LatencyHistogram::getBucket(std::chrono::steady_clock::duration latency)
+{
+    const auto latencyInUsec =
+        std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    if (latencyInUsec <= 0)
+    {
+        return 0;
+    }
+    return std::min<std::size_t>(
+        std::bit_width(static_cast<std::uint64_t>(latencyInUsec)),
+        bucketsCount - 1);
+}
+
+} // namespace data_sync
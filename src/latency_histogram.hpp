@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace data_sync
+{
+
+/**
+ * @class LatencyHistogram
+ *
+ * @brief This class counts the latencies into fixed buckets of powers of two
+ *        microseconds, so that recording a latency is a few instructions
+ *        without any allocation.
+ *
+ * @note The bucket 0 counts the latencies below 1us, and the bucket N counts
+ *       the latencies in [2^(N-1), 2^N) us. The last bucket also counts all
+ *       the latencies beyond its range.
+ */
+class LatencyHistogram
+{
+  public:
+    /**
+     * @brief The number of buckets, where the last bucket starts at ~35
+     *        minutes.
+     */
+    static constexpr std::size_t bucketsCount = 33;
+
+    /**
+     * @brief Count the given latency.
+     *
+     * @param[in] latency - The latency to count
+     *
+     * @return NULL
+     */
+    void record(std::chrono::steady_clock::duration latency);
+
+    /**
+     * @brief Get the counts of all the buckets.
+     *
+     * @return The counts in the order of the buckets.
+     */
+    const std::array<std::uint64_t, bucketsCount>& getCounts() const
+    {
+        return _counts;
+    }
+
+    /**
+     * @brief Get the number of latencies counted.
+     *
+     * @return The total count.
+     */
+    std::uint64_t getTotalCount() const
+    {
+        return _totalCount;
+    }
+
+    /**
+     * @brief Get the upper bound of the bucket of the given percentile.
+     *
+     * @param[in] percentile - The percentile in the range [0, 100]
+     *
+     * @return The latency below which the given percent of the latencies
+     *         fall, in the precision of the buckets; zero if nothing is
+     *         counted.
+     */
+    std::chrono::microseconds getPercentile(double percentile) const;
+
+    /**
+     * @brief Get the bucket of the given latency.
+     *
+     * @param[in] latency - The latency
+     *
+     * @return The bucket index.
+     */
+    static std::size_t getBucket(std::chrono::steady_clock::duration latency);
+
+  private:
+    /**
+     * @brief The counts of the buckets.
+     */
+    std::array<std::uint64_t, bucketsCount> _counts{};
+
+    /**
+     * @brief The number of latencies counted.
+     */
+    std::uint64_t _totalCount{0};
+};
+
+} // namespace data_sync
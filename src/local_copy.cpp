@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "local_copy.hpp"
+
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace data_sync::local_copy
+{
+
+namespace
+{
+
+/**
+ * @brief A helper API to copy the content of the given file descriptors
+ *        within the kernel.
+ *
+ * @param[in] sourceFd - The file to read from its start
+ * @param[in] destFd - The empty file to write into
+ * @param[in] size - The size of the source file
+ *
+ * @return 0 on success; otherwise, the errno of the failure.
+ */
+int copyContent(int sourceFd, int destFd, std::size_t size)
+{
+    bool useSendfile = false;
+    std::size_t copied = 0;
+    while (copied < size)
+    {
+        const auto result =
+            useSendfile
+                ? sendfile(destFd, sourceFd, nullptr, size - copied)
+                : copy_file_range(sourceFd, nullptr, destFd, nullptr,
+                                  size - copied, 0);
+        if (result == 0)
+        {
+            // The source got truncated meanwhile.
+            break;
+        }
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // Older kernels don't support copy_file_range across the file
+            // systems, and some file systems don't support it at all.
+            if (!useSendfile && copied == 0 &&
+                (errno == EXDEV || errno == ENOSYS || errno == EINVAL ||
+                 errno == EOPNOTSUPP))
+            {
+                useSendfile = true;
+                continue;
+            }
+            return errno;
+        }
+        copied += static_cast<std::size_t>(result);
+    }
+    return 0;
+}
+
+/**
+ * @brief A helper API to flush the given directory.
+ *
+ * @param[in] dir - The directory to flush
+ *
+ * @return 0 on success; otherwise, the errno of the failure.
+ */
+int flushDir(const fs::path& dir)
+{
+    utility::FD fd(open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (fd() == -1)
+    {
+        return errno;
+    }
+    return fsync(fd()) == -1 ? errno : 0;
+}
+
+} // namespace
+
+AtomicApply::~AtomicApply()
+{
+    for (const auto& stagedFile : _stagedFiles)
+    {
+        unlink(stagedFile._stagingFile.c_str());
+    }
+}
+
+std::error_code AtomicApply::stage(const fs::path& source,
+                                   const fs::path& dest)
+{
+    utility::FD sourceFd(open(source.c_str(), O_RDONLY | O_CLOEXEC));
+    struct stat sourceStat{};
+    if (sourceFd() == -1 || fstat(sourceFd(), &sourceStat) == -1)
+    {
+        return {errno, std::generic_category()};
+    }
+
+    std::error_code ec;
+    fs::create_directories(dest.parent_path(), ec);
+    if (ec)
+    {
+        return ec;
+    }
+
+    // The staging file gets a unique hidden name, same as rsync does, so
+    // that it neither clobbers an existing file nor gets picked up by the
+    // consumers of the directory.
+    std::string stagingFile =
+        (dest.parent_path() / ("." + dest.filename().string() + ".XXXXXX"))
+            .string();
+    utility::FD destFd(mkostemp(stagingFile.data(), O_CLOEXEC));
+    if (destFd() == -1)
+    {
+        return {errno, std::generic_category()};
+    }
+
+    int err = copyContent(sourceFd(), destFd(),
+                          static_cast<std::size_t>(sourceStat.st_size));
+
+    // The ownership is kept only if permitted, same as rsync --archive does
+    // when not running as root. The permissions are set after it, as the
+    // change of the ownership clears the setuid and setgid bits.
+    const std::array<timespec, 2> times{sourceStat.st_atim,
+                                       sourceStat.st_mtim};
+    if (err == 0 &&
+        fchown(destFd(), sourceStat.st_uid, sourceStat.st_gid) == -1 &&
+        errno != EPERM)
+    {
+        err = errno;
+    }
+    if (err == 0 && fchmod(destFd(), sourceStat.st_mode & 07777) == -1)
+    {
+        err = errno;
+    }
+    if (err == 0 && futimens(destFd(), times.data()) == -1)
+    {
+        err = errno;
+    }
+
+    // The content has to be on the disk before the file is renamed over
+    // its destination.
+    if (err == 0 && fsync(destFd()) == -1)
+    {
+        err = errno;
+    }
+
+    if (err != 0)
+    {
+        unlink(stagingFile.c_str());
+        return {err, std::generic_category()};
+    }
+
+    _stagedFiles.emplace_back(std::move(stagingFile), dest);
+    return {};
+}
+
+void AtomicApply::stageRemoval(const fs::path& dest)
+{
+    _removals.emplace_back(dest);
+}
+
+std::error_code AtomicApply::commit()
+{
+    std::error_code firstEc;
+    const auto setError = [&firstEc](int err) {
+        if (err != 0 && !firstEc)
+        {
+            firstEc = {err, std::generic_category()};
+        }
+    };
+
+    std::set<fs::path> changedDirs;
+    for (const auto& stagedFile : _stagedFiles)
+    {
+        if (rename(stagedFile._stagingFile.c_str(),
+                   stagedFile._dest.c_str()) == -1)
+        {
+            setError(errno);
+            unlink(stagedFile._stagingFile.c_str());
+            continue;
+        }
+        changedDirs.insert(stagedFile._dest.parent_path());
+    }
+    _stagedFiles.clear();
+
+    for (const auto& dest : _removals)
+    {
+        std::error_code ec;
+        fs::remove_all(dest, ec);
+        setError(ec.value());
+        changedDirs.insert(dest.parent_path());
+    }
+    _removals.clear();
+
+    // Persist the renames and removals, one fsync per directory.
+    for (const auto& changedDir : changedDirs)
+    {
+        if (const auto err = flushDir(changedDir); err != ENOENT)
+        {
+            setError(err);
+        }
+    }
+
+    return firstEc;
+}
+
+std::error_code copyFile(const fs::path& source, const fs::path& dest)
+{
+    AtomicApply atomicApply;
+    if (auto ec = atomicApply.stage(source, dest); ec)
+    {
+        return ec;
+    }
+    return atomicApply.commit();
+}
+
+std::error_code removePath(const fs::path& dest)
+{
+    AtomicApply atomicApply;
+    atomicApply.stageRemoval(dest);
+    return atomicApply.commit();
+}
+
+} // namespace data_sync::local_copy
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+namespace data_sync::local_copy
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class AtomicApply
+ *
+ * @brief This class applies a set of synced files into their destination
+ *        such that a consumer of a destination file never sees it partially
+ *        written, even if the BMC crashes in between.
+ *
+ * @note Each file is written and flushed into a staging file next to its
+ *       destination (i.e. in the same file system), and all the staged
+ *       files are renamed over their destination together on commit. The
+ *       renames are then made durable with one fsync per destination
+ *       directory, instead of one per file. The calls block on the disk,
+ *       hence they are not meant to be run on the event loop.
+ */
+class AtomicApply
+{
+  public:
+    AtomicApply() = default;
+    AtomicApply(const AtomicApply&) = delete;
+    AtomicApply& operator=(const AtomicApply&) = delete;
+    AtomicApply(AtomicApply&&) = default;
+    AtomicApply& operator=(AtomicApply&&) = default;
+
+    /**
+     * @brief The destructor removes the staged files which are not
+     *        committed.
+     */
+    ~AtomicApply();
+
+    /**
+     * @brief Copy the given regular file into the staging file of the
+     *        given destination along with its permissions, ownership and
+     *        timestamps.
+     *
+     * @param[in] source - The file to copy
+     * @param[in] dest - The destination file, whose parent directories are
+     *                   created if missing
+     *
+     * @return An empty error code on success; otherwise, the failure reason.
+     *
+     * @note The content is copied within the kernel through
+     *       copy_file_range(2), or sendfile(2) if the file systems don't
+     *       support it, without going through a user space buffer, and
+     *       flushed only to the staging file rather than the whole file
+     *       system.
+     */
+    std::error_code stage(const fs::path& source, const fs::path& dest);
+
+    /**
+     * @brief Record the given destination path to be removed on commit,
+     *        as it got removed from the source.
+     *
+     * @param[in] dest - The file or directory to remove
+     *
+     * @return NULL
+     */
+    void stageRemoval(const fs::path& dest);
+
+    /**
+     * @brief Flush the staged files, move them over their destination and
+     *        remove the destinations staged for removal.
+     *
+     * @return An empty error code on success; otherwise, the reason of the
+     *         first failure, in which case the rest of the files are still
+     *         applied.
+     */
+    std::error_code commit();
+
+  private:
+    /**
+     * @brief The details of a staged file.
+     */
+    struct StagedFile
+    {
+        /**
+         * @brief The staging file holding the new content.
+         */
+        fs::path _stagingFile;
+
+        /**
+         * @brief The destination to replace with the staging file.
+         */
+        fs::path _dest;
+    };
+
+    /**
+     * @brief The files staged to move over their destination.
+     */
+    std::vector<StagedFile> _stagedFiles;
+
+    /**
+     * @brief The destinations to remove.
+     */
+    std::vector<fs::path> _removals;
+};
+
+/**
+ * @brief Copy the given regular file into the given destination atomically.
+ *
+ * @param[in] source - The file to copy
+ * @param[in] dest - The destination file
+ *
+ * @return An empty error code on success; otherwise, the failure reason.
+ *
+ * @note This is a shorthand of AtomicApply for a single file.
+ */
+std::error_code copyFile(const fs::path& source, const fs::path& dest);
+
+/**
+ * @brief Remove the given destination path, which got removed from the
+ *        source.
+ *
+ * @param[in] dest - The file or directory to remove
+ *
+ * @return An empty error code on success or if the path doesn't exist;
+ *         otherwise, the failure reason.
+ */
+std::error_code removePath(const fs::path& dest);
+
+} // namespace data_sync::local_copy
@@ -1,66 +1,1930 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include "config.h"
+
 #include "manager.hpp"
 
-#include <nlohmann/json.hpp>
+#include "async_command_exec.hpp"
+#include "async_thread.hpp"
+#include "config_file_parser.hpp"
+#include "config_snapshot.hpp"
+#include "data_watcher.hpp"
+#include "local_copy.hpp"
+#include "trace.hpp"
+#include "utility.hpp"
+
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+
 #include <phosphor-logging/lg2.hpp>
 
+#include <algorithm>
+#include <array>
 #include <exception>
 #include <fstream>
 #include <iterator>
 #include <ranges>
 #include <string>
 #include <string_view>
+#include <system_error>
 
 namespace data_sync
 {
 
-Manager::Manager(const fs::path& dataSyncCfgDir)
+namespace
+{
+
+/**
+ * @brief A helper API to call the given function with each included path of
+ *        the given data which is present under the given directory.
+ *
+ * @param[in] dataSyncCfg - The data sync config
+ * @param[in] dir - The directory to look for the included paths
+ * @param[in] func - The function to call as func(path)
+ *
+ * @note Only the sub directories which lead to an included path are walked.
+ */
+template <typename Func>
+void forEachIncludedPath(const config::DataSyncConfig& dataSyncCfg,
+                         const fs::path& dir, Func&& func)
+{
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(
+             dir, fs::directory_options::skip_permission_denied, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (dataSyncCfg._includeFileTrie.findLongestPrefix(it->path()) !=
+            nullptr)
+        {
+            func(std::string_view(it->path().native()));
+            it.disable_recursion_pending();
+        }
+        else if (!dataSyncCfg._includeFileTrie.hasPatternUnder(it->path()))
+        {
+            it.disable_recursion_pending();
+        }
+    }
+}
+
+/**
+ * @brief A helper API to get the bytes sent by rsync from its statistics.
+ *
+ * @param[in] output - The output of rsync run with --stats
+ *
+ * @return The total bytes sent; zero if the statistics are not found.
+ */
+std::uint64_t getSentBytes(std::string_view output)
+{
+    constexpr std::string_view sentBytesField{"Total bytes sent: "};
+    const auto fieldPos = output.find(sentBytesField);
+    if (fieldPos == std::string_view::npos)
+    {
+        return 0;
+    }
+
+    // The number may be grouped with commas, e.g. "1,234".
+    std::uint64_t sentBytes{0};
+    for (const auto digit : output.substr(fieldPos + sentBytesField.size()))
+    {
+        if (digit >= '0' && digit <= '9')
+        {
+            sentBytes = (sentBytes * 10) +
+                        static_cast<std::uint64_t>(digit - '0');
+        }
+        else if (digit != ',')
+        {
+            break;
+        }
+    }
+    return sentBytes;
+}
+
+/**
+ * @brief A helper API to get the snapshot of the configuration parsed from
+ *        the configuration files.
+ *
+ * @param[in] persistDir - The directory where the sync state is persisted
+ *
+ * @return The config snapshot.
+ */
+config::ConfigSnapshot getConfigSnapshot(const fs::path& persistDir)
+{
+    return config::ConfigSnapshot(persistDir / "config_snapshot.bin");
+}
+
+/**
+ * @brief A helper API to get the id of this BMC to version the changes made
+ *        on this BMC.
+ *
+ * @return The machine id; the host name if the machine id is not set.
+ */
+std::string getBMCId()
+{
+    std::string bmcId;
+    std::ifstream machineIdFile("/etc/machine-id");
+    if (std::getline(machineIdFile, bmcId) && !bmcId.empty())
+    {
+        return bmcId;
+    }
+
+    std::array<char, HOST_NAME_MAX + 1> hostName{};
+    if (gethostname(hostName.data(), hostName.size()) == 0)
+    {
+        return hostName.data();
+    }
+    return "unknown";
+}
+
+/**
+ * @brief A helper API to split the given NUL separated paths.
+ *
+ * @param[in] pathsToSync - The paths in the rsync --files-from format
+ *
+ * @return The list of paths.
+ */
+std::vector<fs::path> splitPathsToSync(std::string_view pathsToSync)
+{
+    std::vector<fs::path> paths;
+    for (const auto path : pathsToSync | std::views::split('\0'))
+    {
+        if (!path.empty())
+        {
+            paths.emplace_back(std::string_view(path.begin(), path.end()));
+        }
+    }
+    return paths;
+}
+
+/**
+ * @brief A helper API to check whether the given paths can be copied
+ *        directly instead of through rsync.
+ *
+ * @param[in] paths - The paths to sync
+ *
+ * @return true if all the paths are either a regular file or removed.
+ *
+ * @note The directories are left to rsync to sync their content and the
+ *       removals within them.
+ */
+bool canCopyLocally(const std::vector<fs::path>& paths)
+{
+    return std::ranges::all_of(paths, [](const auto& path) {
+        std::error_code ec;
+        const auto type = fs::symlink_status(path, ec).type();
+        return type == fs::file_type::regular ||
+               type == fs::file_type::not_found;
+    });
+}
+
+} // namespace
+
+Manager::Manager(sdbusplus::async::context& ctx,
+                 const fs::path& dataSyncCfgDir,
+                 const std::string& syncDestRoot, const fs::path& persistDir,
+                 bool isLocalCopyAllowed) :
+    _ctx(ctx), _syncDestRoot(syncDestRoot), _persistDir(persistDir),
+    _isLocalCopyEnabled(isLocalCopyAllowed && isLocalDest(syncDestRoot)),
+    _bmcId(getBMCId()),
+    _contentHashCache(_persistDir / "content_hash_cache.json"),
+    _versionStore(_persistDir / "version_store.json"),
+    _syncJournal(_persistDir / "sync_journal"),
+    _syncBandwidth(std::uint64_t{GLOBAL_BANDWIDTH_LIMIT} * 1024,
+                   std::uint64_t{GLOBAL_BANDWIDTH_LIMIT} * 1024),
+    _retryScheduler(MAX_PARALLEL_RETRIES),
+    _syncBufferPool(syncArenaSize, MAX_PARALLEL_SYNCS)
 {
     parseConfiguration(dataSyncCfgDir);
+    _syncMetrics = SyncMetrics(_dataSyncConfiguration.size());
+    _metricsServer.emplace(_ctx.get_bus(), _syncMetrics);
+    for (std::size_t index = 0; index < _dataSyncConfiguration.size();
+         ++index)
+    {
+        if (!_isDataRemoved[index])
+        {
+            _metricsServer->addEntry(index,
+                                     _dataSyncConfiguration[index]._path);
+        }
+    }
+
+    if (auto remoteHost = PeerConnection::getRemoteHost(_syncDestRoot);
+        remoteHost.has_value())
+    {
+        _peerConnection.emplace(_ctx, std::move(*remoteHost),
+                                _persistDir / "peer.sock",
+                                [this]() { onPeerBack(); });
+        _ctx.spawn(_peerConnection->run());
+    }
+
+    _ctx.spawn(monitorBMCRole());
+    _ctx.spawn(monitorConfiguration(dataSyncCfgDir));
+    _ctx.spawn(publishMetrics());
 }
 
 void Manager::parseConfiguration(const fs::path& dataSyncCfgDir)
 {
-    auto parse = [this](const auto& configFile) {
-        try
+    const auto snapshot = getConfigSnapshot(_persistDir);
+    auto dataSyncConfigs = snapshot.load(dataSyncCfgDir);
+    if (!dataSyncConfigs.has_value())
+    {
+        bool isAllParsed = true;
+        dataSyncConfigs = config::parseConfigDir(dataSyncCfgDir, isAllParsed);
+
+        // Keep parsing the files on every start till all are fixed, to not
+        // lose the errors.
+        if (isAllParsed)
         {
-            std::ifstream file;
-            file.open(configFile.path());
+            snapshot.save(dataSyncCfgDir, dataSyncConfigs.value());
+        }
+    }
 
-            nlohmann::json configJSON(nlohmann::json::parse(file));
+    std::ranges::move(dataSyncConfigs.value(),
+                      std::back_inserter(_dataSyncConfiguration));
+    indexConfiguration();
+}
 
-            if (configJSON.contains("Files"))
-            {
-                std::ranges::transform(
-                    configJSON["Files"],
-                    std::back_inserter(this->_dataSyncConfiguration),
-                    [](const auto& element) {
-                    return config::DataSyncConfig(element);
-                });
-            }
-            if (configJSON.contains("Directories"))
+void Manager::indexConfiguration()
+{
+    const auto dataCount = _dataSyncConfiguration.size();
+    _isDataRemoved.resize(dataCount, false);
+    _dataGenerations.resize(dataCount, 0);
+    _isDataWatched.resize(dataCount, false);
+    _isTimerScheduled.resize(dataCount, false);
+
+    std::ranges::for_each(_indicesOfSyncType,
+                          [](auto& indices) { indices.clear(); });
+    _dataSyncCfgIndex = PathTrie<std::size_t>{};
+    for (std::size_t index = 0; index < dataCount; ++index)
+    {
+        _dataSyncCfgPositions.try_emplace(&_dataSyncConfiguration[index],
+                                          index);
+        if (_isDataRemoved[index])
+        {
+            continue;
+        }
+
+        // The path configured again is left out, else the watcher of the
+        // first one skips all the changes as they are owned by another.
+        if (!_dataSyncCfgIndex.insertLiteral(
+                _dataSyncConfiguration[index]._path, index))
+        {
+            lg2::warning("The data : {PATH} is configured more than once, "
+                         "only the first one is synced",
+                         "PATH", _dataSyncConfiguration[index]._path);
+            _isDataRemoved[index] = true;
+            continue;
+        }
+        _indicesOfSyncType[static_cast<std::size_t>(
+                               _dataSyncConfiguration[index]._syncType)]
+            .push_back(index);
+    }
+}
+
+const config::DataSyncConfig*
+    Manager::getOwningDataSyncConfig(const fs::path& path) const
+{
+    const auto* index = _dataSyncCfgIndex.findLongestPrefix(path);
+    return index != nullptr ? &_dataSyncConfiguration[*index] : nullptr;
+}
+
+sdbusplus::async::task<>
+    Manager::monitorConfiguration(fs::path dataSyncCfgDir)
+{
+    try
+    {
+        watch::inotify::DataWatcher configWatcher(
+            _ctx, IN_CLOEXEC, watch::inotify::defaultEventMasks,
+            dataSyncCfgDir);
+
+        while (!_ctx.stop_requested())
+        {
+            co_await configWatcher.onDataChange();
+
+            // Let the update of all the files settle to reload them once.
+            co_await sdbusplus::async::sleep_for(_ctx, configReloadDelay);
+            reloadConfiguration(dataSyncCfgDir);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // TODO Create error log
+        lg2::error("Failed to monitor the configuration : {CONFIG_DIR}, "
+                   "exception : {EXCEPTION}",
+                   "CONFIG_DIR", dataSyncCfgDir, "EXCEPTION", e);
+    }
+}
+
+void Manager::reloadConfiguration(const fs::path& dataSyncCfgDir)
+{
+    bool isAllParsed = true;
+    auto dataSyncConfigs = config::parseConfigDir(dataSyncCfgDir, isAllParsed);
+    if (!isAllParsed)
+    {
+        lg2::error("Skipped reloading the configuration as some files "
+                   "failed to parse");
+        return;
+    }
+    getConfigSnapshot(_persistDir).save(dataSyncCfgDir, dataSyncConfigs);
+
+    // The data is matched by the configured path. The removed data keeps
+    // its position to be revived if configured again.
+    std::map<std::string, std::size_t, std::less<>> positions;
+    for (std::size_t index = 0; index < _dataSyncConfiguration.size();
+         ++index)
+    {
+        positions.try_emplace(_dataSyncConfiguration[index]._path, index);
+    }
+
+    std::vector<bool> isConfigured(_dataSyncConfiguration.size(), false);
+    std::vector<std::size_t> changedIndices;
+    bool isRemoved = false;
+    for (auto& dataSyncCfg : dataSyncConfigs)
+    {
+        const auto position = positions.find(dataSyncCfg._path);
+        if (position == positions.end())
+        {
+            lg2::info("Added the data : {PATH}", "PATH", dataSyncCfg._path);
+            positions.emplace(dataSyncCfg._path,
+                              _dataSyncConfiguration.size());
+            changedIndices.push_back(_dataSyncConfiguration.size());
+            isConfigured.push_back(true);
+            _dataSyncConfiguration.push_back(std::move(dataSyncCfg));
+            continue;
+        }
+
+        // Of the paths configured more than once, the first one in the
+        // order of the config files by name is synced, as on start, where
+        // indexConfiguration() leaves out the rest.
+        const auto index = position->second;
+        if (isConfigured[index])
+        {
+            continue;
+        }
+        isConfigured[index] = true;
+        if (!_isDataRemoved[index] &&
+            _dataSyncConfiguration[index] == dataSyncCfg)
+        {
+            continue;
+        }
+
+        lg2::info("{ACTION} the data : {PATH}", "ACTION",
+                  _isDataRemoved[index] ? "Added" : "Updated", "PATH",
+                  dataSyncCfg._path);
+        disarmData(index);
+        _dataSyncConfiguration[index] = std::move(dataSyncCfg);
+        if (_isDataRemoved[index])
+        {
+            _isDataRemoved[index] = false;
+            _metricsServer->addEntry(index,
+                                     _dataSyncConfiguration[index]._path);
+        }
+        changedIndices.push_back(index);
+    }
+
+    for (std::size_t index = 0; index < _isDataRemoved.size(); ++index)
+    {
+        if (!isConfigured[index] && !_isDataRemoved[index])
+        {
+            lg2::info("Removed the data : {PATH}", "PATH",
+                      _dataSyncConfiguration[index]._path);
+            disarmData(index);
+            _isDataRemoved[index] = true;
+            _metricsServer->removeEntry(index);
+            isRemoved = true;
+        }
+    }
+
+    if (changedIndices.empty() && !isRemoved)
+    {
+        return;
+    }
+
+    const auto dataCount = _isDataRemoved.size();
+    indexConfiguration();
+    _syncMetrics.resize(_dataSyncConfiguration.size());
+    for (auto index = dataCount; index < _dataSyncConfiguration.size();
+         ++index)
+    {
+        _metricsServer->addEntry(index, _dataSyncConfiguration[index]._path);
+    }
+
+    armDataWatchers();
+    for (const auto index : changedIndices)
+    {
+        // Sync the whole path as the changed config may sync it
+        // differently, e.g. with another include list.
+        const auto& dataSyncCfg = _dataSyncConfiguration[index];
+        if (isSourcedByThisBMC(dataSyncCfg) &&
+            _eventCoalescer.addEvents(dataSyncCfg._path, {dataSyncCfg._path}))
+        {
+            _ctx.spawn(coalesceAndSync(dataSyncCfg));
+        }
+    }
+    armSyncTimers();
+}
+
+void Manager::disarmData(std::size_t index)
+{
+    // The watcher of the previous config stops at its next event.
+    _dataGenerations[index]++;
+    _isDataWatched[index] = false;
+    _merkleTrees.erase(_dataSyncConfiguration[index]._path);
+
+    if (_isTimerScheduled[index])
+    {
+        _periodicSyncTimers.cancel(index);
+        _isTimerScheduled[index] = false;
+    }
+}
+
+sdbusplus::async::task<> Manager::monitorBMCRole()
+{
+    using BMCRedundancy =
+        sdbusplus::client::xyz::openbmc_project::state::bmc::Redundancy<>;
+    constexpr auto bmcRedundancyPath = "/xyz/openbmc_project/state/bmc0";
+
+    sdbusplus::async::match roleChanged(
+        _ctx, sdbusplus::bus::match::rules::propertiesChanged(
+                  bmcRedundancyPath, BMCRedundancy::interface));
+    auto bmcRedundancy = BMCRedundancy(_ctx)
+                             .service(BMCRedundancy::interface)
+                             .path(bmcRedundancyPath);
+
+    while (!_ctx.stop_requested())
+    {
+        bool isFetched = true;
+        try
+        {
+            const auto bmcRole = co_await bmcRedundancy.role();
+            if (bmcRole != _bmcRole)
             {
-                std::ranges::transform(
-                    configJSON["Directories"],
-                    std::back_inserter(this->_dataSyncConfiguration),
-                    [](const auto& element) {
-                    return config::DataSyncConfig(element);
-                });
+                lg2::info("The BMC role is changed to {ROLE}", "ROLE",
+                          sdbusplus::message::convert_to_string(bmcRole));
+                _bmcRole = bmcRole;
+                startSyncEvents();
             }
+            co_await roleChanged.next();
         }
         catch (const std::exception& e)
         {
             // TODO Create error log
-            lg2::error("Failed to parse the configuration file : {CONFIG_FILE},"
-                       " exception : {EXCEPTION}",
-                       "CONFIG_FILE", configFile.path(), "EXCEPTION", e);
+            lg2::error("Failed to get the BMC role, exception : {EXCEPTION}",
+                       "EXCEPTION", e);
+            isFetched = false;
         }
-    };
 
-    if (fs::exists(dataSyncCfgDir) && fs::is_directory(dataSyncCfgDir))
+        // The redundancy manager may not be up yet.
+        if (!isFetched)
+        {
+            co_await sdbusplus::async::sleep_for(_ctx, std::chrono::seconds(5));
+        }
+    }
+}
+
+bool Manager::isSourcedByThisBMC(
+    const config::DataSyncConfig& dataSyncCfg) const
+{
+    if (_isDataRemoved[getIndex(dataSyncCfg)])
+    {
+        return false;
+    }
+
+    switch (dataSyncCfg._syncDirection)
+    {
+        case config::SyncDirection::Active2Passive:
+            return _bmcRole == BMCRole::Active;
+        case config::SyncDirection::Passive2Active:
+            return _bmcRole == BMCRole::Passive;
+        case config::SyncDirection::Bidirectional:
+            return _bmcRole != BMCRole::Unknown;
+    }
+    return false;
+}
+
+void Manager::startSyncEvents()
+{
+    // The watchers are armed before the full sync to not miss the changes
+    // happening while the full sync is in progress.
+    armDataWatchers();
+    resumeInterruptedSyncs();
+    startFullSync();
+    armSyncTimers();
+}
+
+void Manager::armDataWatchers()
+{
+    for (const auto index :
+         _indicesOfSyncType[static_cast<std::size_t>(
+             config::SyncType::Immediate)])
+    {
+        if (!_isDataWatched[index] &&
+            isSourcedByThisBMC(_dataSyncConfiguration[index]))
+        {
+            _isDataWatched[index] = true;
+            _ctx.spawn(monitorDataToSync(_dataSyncConfiguration[index]));
+        }
+    }
+
+    // The periodic directories are watched to keep their hash trees, which
+    // spares walking the whole directory on both BMCs at every period.
+    for (const auto index :
+         _indicesOfSyncType[static_cast<std::size_t>(
+             config::SyncType::Periodic)])
+    {
+        if (!_isDataWatched[index] &&
+            _dataSyncConfiguration[index]._isPathDir &&
+            isSourcedByThisBMC(_dataSyncConfiguration[index]))
+        {
+            _isDataWatched[index] = true;
+            _ctx.spawn(monitorDataToSync(_dataSyncConfiguration[index]));
+        }
+    }
+}
+
+void Manager::armSyncTimers()
+{
+    bool isTimerScheduled = false;
+    for (const auto index :
+         _indicesOfSyncType[static_cast<std::size_t>(
+             config::SyncType::Periodic)])
+    {
+        if (!_isTimerScheduled[index] &&
+            isSourcedByThisBMC(_dataSyncConfiguration[index]))
+        {
+            _isTimerScheduled[index] = true;
+            _periodicSyncTimers.schedule(index,
+                                         getTicksToNextSync(index, true));
+            isTimerScheduled = true;
+        }
+    }
+
+    // The running task may sleep past the new timers, hence a new task
+    // takes over from it.
+    if (isTimerScheduled)
+    {
+        _ctx.spawn(monitorTimerToSync(++_timerMonitorGeneration));
+    }
+}
+
+void Manager::resumeInterruptedSyncs()
+{
+    // Copy as the journal forgets the interrupted syncs as they end.
+    const auto interruptedSyncs = _syncJournal.getInterruptedSyncs();
+    for (const auto& [journalId, journalEntry] : interruptedSyncs)
+    {
+        const auto cfgIt = std::ranges::find(_dataSyncConfiguration,
+                                             journalEntry._dataSyncCfgPath,
+                                             &config::DataSyncConfig::_path);
+
+        // The paths of the same data are synced by the ongoing resume, and
+        // the data which is not configured anymore or not sourced by this
+        // BMC after a role change is not synced.
+        if (cfgIt == _dataSyncConfiguration.end() ||
+            !isSourcedByThisBMC(*cfgIt) ||
+            !_eventCoalescer.addEvents(cfgIt->_path, journalEntry._paths))
+        {
+            _syncJournal.end(journalId);
+            continue;
+        }
+
+        lg2::info("Resuming the interrupted sync of the data : {PATH}", "PATH",
+                  cfgIt->_path);
+        _ctx.spawn(enqueueClaimedPaths(
+            *cfgIt, _eventCoalescer.takeEvents(cfgIt->_path), false,
+            std::chrono::steady_clock::now(), journalId));
+    }
+}
+
+void Manager::startFullSync()
+{
+    const auto totalEntries = std::ranges::count_if(
+        _dataSyncConfiguration, [this](const auto& dataSyncCfg) {
+        return isSourcedByThisBMC(dataSyncCfg);
+    });
+    _fullSyncProgress =
+        FullSyncProgress{static_cast<std::size_t>(totalEntries), 0, 0,
+                         std::chrono::steady_clock::now()};
+
+    lg2::info("Starting the full sync of {ENTRIES} entries", "ENTRIES",
+              _fullSyncProgress._totalEntries);
+
+    for (const auto& dataSyncCfg : _dataSyncConfiguration)
+    {
+        if (!isSourcedByThisBMC(dataSyncCfg))
+        {
+            continue;
+        }
+
+        // Leave the entries which are already being synced due to a change,
+        // the ongoing sync will sync them again with the whole path.
+        if (!_eventCoalescer.addEvents(dataSyncCfg._path,
+                                       {dataSyncCfg._path}))
+        {
+            _fullSyncProgress._syncedEntries++;
+            continue;
+        }
+
+        // The full sync sends every path, including the ones unchanged since
+        // the last sync, as the sibling may have lost them meanwhile.
+        _ctx.spawn(enqueueClaimedPaths(
+            dataSyncCfg, _eventCoalescer.takeEvents(dataSyncCfg._path), true,
+            _fullSyncProgress._startTime));
+    }
+}
+
+void Manager::onPeerBack()
+{
+    // The full sync starts along with the sync events once the role is
+    // known.
+    if (_bmcRole == BMCRole::Unknown)
+    {
+        return;
+    }
+
+    // The sibling BMC may have lost the data while it was away.
+    startFullSync();
+}
+
+void Manager::updateFullSyncProgress(bool isSynced)
+{
+    if (isSynced)
+    {
+        _fullSyncProgress._syncedEntries++;
+    }
+    else
+    {
+        _fullSyncProgress._failedEntries++;
+    }
+
+    const auto doneEntries = _fullSyncProgress._syncedEntries +
+                             _fullSyncProgress._failedEntries;
+    if (doneEntries < _fullSyncProgress._totalEntries)
+    {
+        lg2::debug("Full sync progress : {DONE}/{TOTAL} entries, {FAILED} "
+                   "failed",
+                   "DONE", doneEntries, "TOTAL",
+                   _fullSyncProgress._totalEntries, "FAILED",
+                   _fullSyncProgress._failedEntries);
+        return;
+    }
+
+    lg2::info("Completed the full sync of {TOTAL} entries in {DURATION} ms, "
+              "{FAILED} failed",
+              "TOTAL", _fullSyncProgress._totalEntries, "DURATION",
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  std::chrono::steady_clock::now() -
+                  _fullSyncProgress._startTime)
+                  .count(),
+              "FAILED", _fullSyncProgress._failedEntries);
+}
+
+sdbusplus::async::task<>
+    Manager::monitorDataToSync(const config::DataSyncConfig& dataSyncCfg)
+{
+    const auto index = getIndex(dataSyncCfg);
+    const auto generation = _dataGenerations[index];
+    try
+    {
+        watch::inotify::DataWatcher dataWatcher(
+            _ctx, IN_CLOEXEC, watch::inotify::defaultEventMasks,
+            dataSyncCfg._path, [this, &dataSyncCfg](const fs::path& path) {
+            // The paths configured separately under the directory are
+            // synced as per their own config.
+            return dataSyncCfg.isPathToSync(path) &&
+                   getOwningDataSyncConfig(path) == &dataSyncCfg;
+        });
+
+        MerkleTrees* merkleTrees = nullptr;
+        if (dataSyncCfg._syncType == config::SyncType::Periodic)
+        {
+            merkleTrees =
+                &_merkleTrees
+                     .try_emplace(dataSyncCfg._path,
+                                  MerkleTrees{MerkleTree(dataSyncCfg._path),
+                                              MerkleTree(dataSyncCfg._path),
+                                              {}})
+                     .first->second;
+            updateMerkleTree(dataSyncCfg, dataSyncCfg._path,
+                             merkleTrees->_current);
+        }
+
+        while (!_ctx.stop_requested())
+        {
+            auto changedPaths = co_await dataWatcher.onDataChange();
+            DATA_SYNC_TRACE(sync_event, dataSyncCfg._path.c_str(),
+                            changedPaths.size());
+            if (_dataGenerations[index] != generation)
+            {
+                lg2::info("Stopped monitoring the data : {PATH} as its "
+                          "config is reloaded",
+                          "PATH", dataSyncCfg._path);
+                break;
+            }
+            if (!isSourcedByThisBMC(dataSyncCfg))
+            {
+                lg2::info("Stopped monitoring the data : {PATH} as this BMC "
+                          "is no longer its source",
+                          "PATH", dataSyncCfg._path);
+                break;
+            }
+
+            if (merkleTrees != nullptr)
+            {
+                for (const auto& changedPath : changedPaths)
+                {
+                    updateMerkleTree(dataSyncCfg, changedPath,
+                                     merkleTrees->_current);
+                }
+                merkleTrees->_changedPaths.insert(changedPaths.begin(),
+                                                  changedPaths.end());
+                continue;
+            }
+
+            if (!changedPaths.empty() &&
+                _eventCoalescer.addEvents(dataSyncCfg._path, changedPaths))
+            {
+                _ctx.spawn(coalesceAndSync(dataSyncCfg));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // TODO Create error log
+        lg2::error("Failed to monitor the data : {PATH}, exception : "
+                   "{EXCEPTION}",
+                   "PATH", dataSyncCfg._path, "EXCEPTION", e);
+    }
+
+    // The state of the reloaded data belongs to its new watcher.
+    if (_dataGenerations[index] == generation)
     {
-        std::ranges::for_each(fs::directory_iterator(dataSyncCfgDir), parse);
+        _merkleTrees.erase(dataSyncCfg._path);
+        _isDataWatched[index] = false;
     }
 }
+
+sdbusplus::async::task<>
+    Manager::monitorTimerToSync(std::uint64_t generation)
+{
+    // The timer wheel ticks every second
+    using Tick = std::chrono::seconds;
+    const auto startTime = _periodicSyncStartTime;
+
+    while (!_ctx.stop_requested() && generation == _timerMonitorGeneration)
+    {
+        const auto nextWakeupTick = _periodicSyncTimers.getNextWakeupTick();
+        if (!nextWakeupTick.has_value())
+        {
+            break;
+        }
+
+        const auto wakeupTime = startTime + Tick(*nextWakeupTick);
+        const auto now = std::chrono::steady_clock::now();
+        if (wakeupTime > now)
+        {
+            co_await sdbusplus::async::sleep_for(_ctx, wakeupTime - now);
+            if (generation != _timerMonitorGeneration)
+            {
+                break;
+            }
+        }
+
+        const auto currentTick = std::chrono::duration_cast<Tick>(
+            std::chrono::steady_clock::now() - startTime);
+        for (const auto index :
+             _periodicSyncTimers.advanceTo(currentTick.count()))
+        {
+            const auto& dataSyncCfg = _dataSyncConfiguration[index];
+            if (!isSourcedByThisBMC(dataSyncCfg))
+            {
+                _isTimerScheduled[index] = false;
+                continue;
+            }
+
+            if (_eventCoalescer.addEvents(dataSyncCfg._path,
+                                          getPeriodicPathsToSync(dataSyncCfg)))
+            {
+                if (auto merkleTrees = _merkleTrees.find(dataSyncCfg._path);
+                    merkleTrees != _merkleTrees.end())
+                {
+                    merkleTrees->second._changedPaths.clear();
+                }
+                _ctx.spawn(coalesceAndSync(dataSyncCfg));
+            }
+            _periodicSyncTimers.schedule(index,
+                                         getTicksToNextSync(index, false));
+        }
+    }
+}
+
+void Manager::updateMerkleTree(const config::DataSyncConfig& dataSyncCfg,
+                               const fs::path& path,
+                               MerkleTree& merkleTree) const
+{
+    const auto isPathToSync = [this, &dataSyncCfg](const fs::path& filePath) {
+        return dataSyncCfg.isPathToSync(filePath) &&
+               getOwningDataSyncConfig(filePath) == &dataSyncCfg;
+    };
+    const auto updateFile = [&merkleTree](const fs::path& filePath,
+                                          const fs::file_status& status) {
+        std::error_code ec;
+        const auto fileSize = fs::file_size(filePath, ec);
+        const auto mtime = fs::last_write_time(filePath, ec);
+        if (!fs::is_regular_file(status) || ec)
+        {
+            merkleTree.update(filePath, std::nullopt);
+            return;
+        }
+
+        // The size and the modification time identify the content the
+        // way rsync compares the files, which spares hashing the content.
+        std::array<std::uint64_t, 2> fileState{
+            fileSize,
+            static_cast<std::uint64_t>(mtime.time_since_epoch().count())};
+        merkleTree.update(
+            filePath,
+            ContentHashCache::hash(std::string_view(
+                reinterpret_cast<const char*>(fileState.data()),
+                sizeof(fileState))));
+    };
+
+    std::error_code ec;
+    const auto status = fs::symlink_status(path, ec);
+    if (!fs::is_directory(status))
+    {
+        if (isPathToSync(path))
+        {
+            updateFile(path, status);
+        }
+        else
+        {
+            merkleTree.update(path, std::nullopt);
+        }
+        return;
+    }
+
+    merkleTree.update(path, std::nullopt);
+    for (auto it = fs::recursive_directory_iterator(path, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (!it->is_directory(ec) && isPathToSync(it->path()))
+        {
+            updateFile(it->path(), it->symlink_status(ec));
+        }
+    }
+}
+
+std::vector<fs::path> Manager::getPeriodicPathsToSync(
+    const config::DataSyncConfig& dataSyncCfg) const
+{
+    // The tree tells only what changed on this BMC, while the copy of the
+    // sibling BMC may have drifted meanwhile (e.g. changed or restored
+    // there). Hence the whole path is synced if nothing changed here, to
+    // let rsync compare it with the copy of the sibling BMC.
+    const auto merkleTrees = _merkleTrees.find(dataSyncCfg._path);
+    if (merkleTrees == _merkleTrees.end())
+    {
+        return {dataSyncCfg._path};
+    }
+    auto changedPaths =
+        merkleTrees->second._synced.diff(merkleTrees->second._current);
+    if (changedPaths.empty())
+    {
+        return {dataSyncCfg._path};
+    }
+    return changedPaths;
+}
+
+void Manager::updateSyncedMerkleTree(const SyncRequest& syncRequest)
+{
+    const auto merkleTrees =
+        _merkleTrees.find(syncRequest._dataSyncCfg->_path);
+    if (merkleTrees == _merkleTrees.end())
+    {
+        return;
+    }
+    auto& [currentTree, syncedTree, changedPaths] = merkleTrees->second;
+
+    MerkleTree unsyncedTree(syncRequest._dataSyncCfg->_path);
+    for (const auto& changedPath : changedPaths)
+    {
+        unsyncedTree.assign(changedPath, syncedTree);
+    }
+    for (const auto& syncedPath :
+         syncRequest._changedFileStates | std::views::keys)
+    {
+        syncedTree.assign(syncedPath, currentTree);
+    }
+    for (const auto& changedPath : changedPaths)
+    {
+        syncedTree.assign(changedPath, unsyncedTree);
+    }
+}
+
+TimerWheel::Tick Manager::getTicksToNextSync(std::size_t index,
+                                             bool isFirstSync)
+{
+    const auto periodicity = std::max<TimerWheel::Tick>(
+        _dataSyncConfiguration[index]
+            ._periodicityInSec.value_or(std::chrono::seconds::zero())
+            .count(),
+        1);
+
+    if (isFirstSync)
+    {
+        // Spread the first sync across the period so that the data with the
+        // same periodicity doesn't fire together.
+        std::uniform_int_distribution<TimerWheel::Tick> phase(1, periodicity);
+        return phase(_jitterEngine);
+    }
+
+    // Jitter by 5% of the period to avoid getting into lockstep with
+    // other periodic activities.
+    const auto maxJitter = periodicity / 20;
+    std::uniform_int_distribution<TimerWheel::Tick> jitter(0, 2 * maxJitter);
+    return periodicity - maxJitter + jitter(_jitterEngine);
+}
+
+sdbusplus::async::task<>
+    Manager::coalesceAndSync(const config::DataSyncConfig& dataSyncCfg)
+{
+    const auto quietWindow = dataSyncCfg._quietWindowInMsec.value_or(
+        std::chrono::milliseconds(DEFAULT_QUIET_WINDOW));
+    const auto maxLatency = std::max<EventCoalescer::Clock::duration>(
+        quietWindow, std::chrono::milliseconds(MAX_COALESCE_LATENCY));
+
+    while (auto timeToSettle = _eventCoalescer.timeToSettle(
+               dataSyncCfg._path, quietWindow, maxLatency))
+    {
+        if (*timeToSettle > EventCoalescer::Clock::duration::zero())
+        {
+            co_await sdbusplus::async::sleep_for(_ctx, *timeToSettle);
+            continue;
+        }
+
+        const auto coalescedTime = std::chrono::steady_clock::now();
+        const auto firstEventTime =
+            _eventCoalescer.getFirstEventTime(dataSyncCfg._path)
+                .value_or(coalescedTime);
+        _syncMetrics.recordStageLatency(SyncStage::Coalesce,
+                                        coalescedTime - firstEventTime);
+
+        auto changedFileStates = co_await getChangedFileStates(
+            _eventCoalescer.takeEvents(dataSyncCfg._path));
+        DATA_SYNC_TRACE(sync_coalesced, dataSyncCfg._path.c_str(),
+                        changedFileStates.size());
+
+        // The periodic sync also repairs the copy of the sibling BMC, which
+        // may differ even if nothing changed here since the last sync.
+        if (dataSyncCfg._syncType != config::SyncType::Periodic &&
+            std::ranges::all_of(changedFileStates, [this](const auto& entry) {
+            return entry.second.has_value() &&
+                   _contentHashCache.isUnchanged(entry.first,
+                                                 getDestPath(entry.first),
+                                                 entry.second.value());
+        }))
+        {
+            lg2::debug("Skipping the sync of {PATH} as the content is "
+                       "unchanged since the last sync",
+                       "PATH", dataSyncCfg._path);
+            continue;
+        }
+
+        if (dataSyncCfg._syncDirection == config::SyncDirection::Bidirectional)
+        {
+            co_await resolveVersions(changedFileStates);
+            if (changedFileStates.empty())
+            {
+                continue;
+            }
+        }
+        _syncMetrics.recordStageLatency(SyncStage::Filter,
+                                        std::chrono::steady_clock::now() -
+                                            coalescedTime);
+
+        // The path stays claimed in the coalescer till the queued sync is
+        // done, which continues the draining afterwards.
+        enqueueSync(dataSyncCfg, std::move(changedFileStates), false,
+                    firstEventTime);
+        co_return;
+    }
+}
+
+void Manager::enqueueSync(
+    const config::DataSyncConfig& dataSyncCfg,
+    std::vector<std::pair<fs::path, std::optional<FileState>>>
+        changedFileStates,
+    bool isFullSync, std::chrono::steady_clock::time_point firstEventTime)
+{
+    auto syncOptions = getSyncOptions(dataSyncCfg, changedFileStates);
+    SyncRequest syncRequest{&dataSyncCfg, std::move(syncOptions),
+                            std::move(changedFileStates), isFullSync};
+    syncRequest._firstEventTime = firstEventTime;
+    submitSyncRequest(std::move(syncRequest));
+}
+
+sdbusplus::async::task<> Manager::enqueueClaimedPaths(
+    const config::DataSyncConfig& dataSyncCfg, std::set<fs::path> claimedPaths,
+    bool isFullSync, std::chrono::steady_clock::time_point firstEventTime,
+    std::optional<std::uint64_t> journalId)
+{
+    auto changedFileStates = co_await getChangedFileStates(claimedPaths);
+    auto syncOptions = getSyncOptions(dataSyncCfg, changedFileStates);
+    SyncRequest syncRequest{&dataSyncCfg, std::move(syncOptions),
+                            std::move(changedFileStates), isFullSync};
+    syncRequest._firstEventTime = firstEventTime;
+    syncRequest._journalId = journalId;
+    submitSyncRequest(std::move(syncRequest));
+}
+
+void Manager::submitSyncRequest(SyncRequest syncRequest)
+{
+    DATA_SYNC_TRACE(sync_queued, syncRequest._dataSyncCfg->_path.c_str(),
+                    syncRequest._changedFileStates.size());
+    syncRequest._queuedTime = std::chrono::steady_clock::now();
+    const auto priority = syncRequest._dataSyncCfg->_priority;
+    _syncQueues[static_cast<std::size_t>(priority)].push_back(
+        std::move(syncRequest));
+
+    if (_activeSyncWorkers < MAX_PARALLEL_SYNCS)
+    {
+        _activeSyncWorkers++;
+        _ctx.spawn(runSyncWorker());
+    }
+    else
+    {
+        preemptLowerPrioritySync(priority);
+    }
+}
+
+bool Manager::scheduleRetry(SyncRequest& syncRequest)
+{
+    const auto& dataSyncCfg = *syncRequest._dataSyncCfg;
+    const auto retry = dataSyncCfg._retry.value_or(config::Retry(
+        DEFAULT_RETRY_ATTEMPTS, std::chrono::seconds(DEFAULT_RETRY_INTERVAL)));
+
+    const auto retryDelay = RetryScheduler::getRetryDelay(
+        retry, syncRequest._retryCount, _jitterEngine);
+    if (!retryDelay.has_value())
+    {
+        if (syncRequest._retryCount > 0)
+        {
+            lg2::error("Failed to sync the data : {PATH} after {COUNT} "
+                       "retries",
+                       "PATH", dataSyncCfg._path, "COUNT",
+                       syncRequest._retryCount);
+        }
+        return false;
+    }
+
+    _ctx.spawn(retrySync(std::move(syncRequest), retryDelay.value()));
+    return true;
+}
+
+sdbusplus::async::task<>
+    Manager::retrySync(SyncRequest syncRequest,
+                       RetryScheduler::Clock::duration retryDelay)
+{
+    co_await sdbusplus::async::sleep_for(_ctx, retryDelay);
+
+    // The role may have changed or the data may have been removed from
+    // the configuration while waiting to retry.
+    if (!isSourcedByThisBMC(*syncRequest._dataSyncCfg))
+    {
+        dropSyncRequest(syncRequest);
+        co_return;
+    }
+
+    syncRequest._retryCount++;
+    _syncMetrics.recordRetry(getIndex(*syncRequest._dataSyncCfg));
+    lg2::info("Retrying the sync of the data : {PATH}, attempt : {COUNT}",
+              "PATH", syncRequest._dataSyncCfg->_path, "COUNT",
+              syncRequest._retryCount);
+    submitSyncRequest(std::move(syncRequest));
+}
+
+void Manager::dropSyncRequest(SyncRequest& syncRequest)
+{
+    const auto& dataSyncCfg = *syncRequest._dataSyncCfg;
+    lg2::info("Dropping the sync of the data : {PATH} as it is {REASON}",
+              "PATH", dataSyncCfg._path, "REASON",
+              _isDataRemoved[getIndex(dataSyncCfg)]
+                  ? "removed from the configuration"
+                  : "not sourced by this BMC anymore");
+
+    if (syncRequest._hasRetrySlot)
+    {
+        _retryScheduler.release();
+        syncRequest._hasRetrySlot = false;
+    }
+    if (syncRequest._journalId.has_value())
+    {
+        _syncJournal.end(syncRequest._journalId.value());
+    }
+    if (syncRequest._isFullSync)
+    {
+        updateFullSyncProgress(false);
+    }
+
+    // Release the path along with the changes that came meanwhile, which
+    // are not synced by this BMC either.
+    _eventCoalescer.takeEvents(dataSyncCfg._path);
+    _eventCoalescer.timeToSettle(dataSyncCfg._path,
+                                 EventCoalescer::Clock::duration::zero(),
+                                 EventCoalescer::Clock::duration::zero());
+}
+
+void Manager::preemptLowerPrioritySync(config::Priority priority)
+{
+    if (priority != config::Priority::High ||
+        std::ranges::any_of(_activeSyncs, [](const auto* activeSync) {
+        return activeSync->_isPreempted;
+    }))
+    {
+        return;
+    }
+
+    auto lowestIt = std::ranges::max_element(
+        _activeSyncs, {},
+        [](const auto* activeSync) { return activeSync->_priority; });
+    if (lowestIt == _activeSyncs.end() || (*lowestIt)->_priority <= priority ||
+        (*lowestIt)->_pid == -1)
+    {
+        return;
+    }
+
+    if (kill((*lowestIt)->_pid, SIGTERM) == 0)
+    {
+        (*lowestIt)->_isPreempted = true;
+    }
+}
+
+bool Manager::isSyncQueueEmpty() const
+{
+    return std::ranges::all_of(_syncQueues, [](const auto& syncQueue) {
+        return syncQueue.empty();
+    });
+}
+
+std::vector<Manager::SyncRequest> Manager::takeSyncBatch()
+{
+    auto& syncQueue = *std::ranges::find_if(
+        _syncQueues, [](const auto& queue) { return !queue.empty(); });
+
+    std::vector<SyncRequest> syncBatch;
+    syncBatch.push_back(std::move(syncQueue.front()));
+    syncQueue.pop_front();
+
+    // Pack the queued requests which share the same sync options and the
+    // bandwidth limit into the same transfer.
+    auto pathsCount = syncBatch.front()._changedFileStates.size();
+    for (auto it = syncQueue.begin();
+         it != syncQueue.end() && pathsCount < maxPathsPerBatch;)
+    {
+        if (it->_syncOptions != syncBatch.front()._syncOptions ||
+            it->_dataSyncCfg->_bandwidthLimitInKBps !=
+                syncBatch.front()._dataSyncCfg->_bandwidthLimitInKBps ||
+            pathsCount + it->_changedFileStates.size() > maxPathsPerBatch)
+        {
+            ++it;
+            continue;
+        }
+        pathsCount += it->_changedFileStates.size();
+        syncBatch.push_back(std::move(*it));
+        it = syncQueue.erase(it);
+    }
+
+    return syncBatch;
+}
+
+sdbusplus::async::task<> Manager::runSyncWorker()
+{
+    try
+    {
+        co_await drainSyncQueue();
+    }
+    catch (const std::exception& e)
+    {
+        // TODO Create error log
+        lg2::error("The sync worker stopped, exception : {EXCEPTION}",
+                   "EXCEPTION", e);
+    }
+
+    // The worker slot is given back however the worker stops, so that the
+    // queued data is still synced by a new worker.
+    _activeSyncWorkers--;
+    if (!isSyncQueueEmpty() && _activeSyncWorkers < MAX_PARALLEL_SYNCS)
+    {
+        _activeSyncWorkers++;
+        _ctx.spawn(runSyncWorker());
+    }
+}
+
+sdbusplus::async::task<> Manager::drainSyncQueue()
+{
+    while (!isSyncQueueEmpty())
+    {
+        auto syncBatch = takeSyncBatch();
+
+        // The role may have changed or the data may have been removed
+        // from the configuration while the requests were queued.
+        std::erase_if(syncBatch, [this](auto& syncRequest) {
+            if (isSourcedByThisBMC(*syncRequest._dataSyncCfg))
+            {
+                return false;
+            }
+            dropSyncRequest(syncRequest);
+            return true;
+        });
+
+        // The retries take a slot as their transfer starts, so that only a
+        // few transfers probe the sibling BMC while it is not reachable.
+        // The ones finding no slot are queued again once a retry finishes.
+        std::erase_if(syncBatch, [this](auto& syncRequest) {
+            if (syncRequest._retryCount == 0 || _retryScheduler.tryAcquire())
+            {
+                syncRequest._hasRetrySlot = syncRequest._retryCount > 0;
+                return false;
+            }
+            _retryScheduler.waitForSlot(
+                [this, syncRequest = std::move(syncRequest)]() mutable {
+                submitSyncRequest(std::move(syncRequest));
+            });
+            return true;
+        });
+        if (syncBatch.empty())
+        {
+            continue;
+        }
+
+        for (auto& syncRequest : syncBatch)
+        {
+            if (!syncRequest._journalId.has_value())
+            {
+                std::vector<fs::path> paths;
+                std::ranges::copy(syncRequest._changedFileStates |
+                                      std::views::keys,
+                                  std::back_inserter(paths));
+                syncRequest._journalId = _syncJournal.begin(
+                    syncRequest._dataSyncCfg->_path, paths);
+            }
+        }
+
+        ActiveSync activeSync{syncBatch.front()._dataSyncCfg->_priority};
+        _activeSyncs.push_back(&activeSync);
+        const auto syncStartTime = std::chrono::steady_clock::now();
+        for (const auto& syncRequest : syncBatch)
+        {
+            _syncMetrics.recordStageLatency(
+                SyncStage::Queue, syncStartTime - syncRequest._queuedTime);
+        }
+        DATA_SYNC_TRACE(sync_start,
+                        syncBatch.front()._dataSyncCfg->_path.c_str(),
+                        syncBatch.size());
+
+        bool isSynced = false;
+        try
+        {
+            isSynced = co_await syncData(syncBatch, activeSync);
+        }
+        catch (const std::exception& e)
+        {
+            // TODO Create error log
+            lg2::error("Failed to sync the data : {PATH} (and {COUNT} more), "
+                       "exception : {EXCEPTION}",
+                       "PATH", syncBatch.front()._dataSyncCfg->_path, "COUNT",
+                       syncBatch.size() - 1, "EXCEPTION", e);
+        }
+        const auto syncEndTime = std::chrono::steady_clock::now();
+        const auto syncLatency =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                syncEndTime - syncStartTime);
+        _syncMetrics.recordStageLatency(SyncStage::Transfer,
+                                        syncEndTime - syncStartTime);
+        DATA_SYNC_TRACE(sync_done,
+                        syncBatch.front()._dataSyncCfg->_path.c_str(),
+                        isSynced, syncLatency.count());
+        std::erase(_activeSyncs, &activeSync);
+
+        if (!isSynced && activeSync._isPreempted)
+        {
+            // The retries give back their slot while queued.
+            for (auto& syncRequest : syncBatch)
+            {
+                if (syncRequest._hasRetrySlot)
+                {
+                    _retryScheduler.release();
+                    syncRequest._hasRetrySlot = false;
+                }
+            }
+
+            // Sync again ahead of the same priority data, the paths are
+            // still claimed by the batch.
+            auto& syncQueue =
+                _syncQueues[static_cast<std::size_t>(activeSync._priority)];
+            syncQueue.insert(syncQueue.begin(),
+                             std::make_move_iterator(syncBatch.begin()),
+                             std::make_move_iterator(syncBatch.end()));
+            continue;
+        }
+
+        for (auto& syncRequest : syncBatch)
+        {
+            if (syncRequest._hasRetrySlot)
+            {
+                _retryScheduler.release();
+                syncRequest._hasRetrySlot = false;
+            }
+
+            // The path stays claimed till the retries are done.
+            if (!isSynced && scheduleRetry(syncRequest))
+            {
+                continue;
+            }
+            _syncJournal.end(syncRequest._journalId.value());
+            _syncMetrics.recordSync(getIndex(*syncRequest._dataSyncCfg),
+                                    syncLatency, isSynced);
+            if (isSynced)
+            {
+                _syncMetrics.recordStageLatency(
+                    SyncStage::EndToEnd,
+                    syncEndTime - syncRequest._firstEventTime);
+                updateContentHashCache(syncRequest._changedFileStates);
+                updateSyncedMerkleTree(syncRequest);
+            }
+            if (syncRequest._isFullSync)
+            {
+                updateFullSyncProgress(isSynced);
+            }
+
+            // Release the path and sync the changes that came meanwhile.
+            _ctx.spawn(coalesceAndSync(*syncRequest._dataSyncCfg));
+        }
+    }
+}
+
+void Manager::updateContentHashCache(
+    const std::vector<std::pair<fs::path, std::optional<FileState>>>&
+        syncedFileStates)
+{
+    std::ranges::for_each(syncedFileStates, [this](const auto& entry) {
+        if (entry.second.has_value())
+        {
+            _contentHashCache.update(entry.first, getDestPath(entry.first),
+                                     entry.second.value());
+        }
+        else
+        {
+            _contentHashCache.remove(entry.first);
+        }
+    });
+
+    schedulePersist();
+}
+
+void Manager::schedulePersist()
+{
+    if ((_contentHashCache.isDirty() || _versionStore.isDirty()) &&
+        !_isCachePersistScheduled)
+    {
+        _isCachePersistScheduled = true;
+        _ctx.spawn(persistContentHashCache());
+    }
+}
+
+sdbusplus::async::task<> Manager::resolveVersions(
+    std::vector<std::pair<fs::path, std::optional<FileState>>>&
+        changedFileStates)
+{
+    const auto conflictsDir = _persistDir / "conflicts";
+    std::vector<std::pair<fs::path, std::optional<FileState>>> pathsToSync;
+    for (auto& [path, fileState] : changedFileStates)
+    {
+        std::error_code ec;
+        const auto pathStatus = fs::symlink_status(path, ec);
+        const auto backupFile = conflictsDir / path.relative_path();
+        if (pathStatus.type() == fs::file_type::not_found)
+        {
+            // rsync moves the files it deletes into the backup dir as well,
+            // hence the backup of a removed path tells that the removal is
+            // received from the sibling BMC, which isn't synced back.
+            const bool isReceived =
+                fs::exists(fs::symlink_status(backupFile, ec));
+            local_copy::removePath(backupFile);
+            if (isReceived)
+            {
+                _contentHashCache.remove(path);
+                continue;
+            }
+            pathsToSync.emplace_back(std::move(path), std::move(fileState));
+            continue;
+        }
+
+        // The directories and the other non regular files are synced as
+        // is, the backups under a directory are cleaned up along with the
+        // files themselves.
+        if (!fs::is_regular_file(pathStatus))
+        {
+            if (!fs::is_directory(pathStatus))
+            {
+                local_copy::removePath(backupFile);
+            }
+            pathsToSync.emplace_back(std::move(path), std::move(fileState));
+            continue;
+        }
+
+        auto localVersion = _versionStore.get(path);
+        const auto fileVersion = VersionVector::read(path);
+        bool isReceived = false;
+
+        if (!fileVersion.has_value() || fileVersion.value() == localVersion)
+        {
+            // Changed on this BMC.
+            localVersion.increment(_bmcId);
+        }
+        else if (const auto order = fileVersion->compare(localVersion);
+                 order == VersionVector::Order::After ||
+                 (order == VersionVector::Order::Concurrent &&
+                  fileVersion->isPreferredOver(localVersion)))
+        {
+            // Received from the sibling BMC with a newer version, which
+            // doesn't need to be synced back.
+            if (order == VersionVector::Order::Concurrent)
+            {
+                lg2::info("Resolved the conflicting changes of {PATH} with "
+                          "the version of the sibling BMC",
+                          "PATH", path);
+            }
+            localVersion.merge(fileVersion.value());
+            isReceived = true;
+        }
+        else
+        {
+            // Received an older or the losing version, bring back the
+            // version which the transfer overwrote and sync it instead.
+            lg2::info("Resolved the conflicting changes of {PATH} with the "
+                      "version of this BMC",
+                      "PATH", path);
+            if (fs::exists(backupFile, ec))
+            {
+                if (const auto restoreEc =
+                        local_copy::copyFile(backupFile, path);
+                    restoreEc)
+                {
+                    lg2::error("Failed to restore the data : {PATH}, error : "
+                               "{ERROR}",
+                               "PATH", path, "ERROR", restoreEc.message());
+                }
+                fileState =
+                    co_await _contentHashCache.getFileState(_ctx, path);
+            }
+            localVersion.merge(fileVersion.value());
+            localVersion.increment(_bmcId);
+        }
+
+        local_copy::removePath(backupFile);
+        if (!localVersion.write(path))
+        {
+            lg2::error("Failed to write the version of the data : {PATH}",
+                       "PATH", path);
+        }
+        _versionStore.set(path, localVersion);
+
+        if (isReceived)
+        {
+            if (fileState.has_value())
+            {
+                _contentHashCache.update(path, getDestPath(path),
+                                         fileState.value());
+            }
+            continue;
+        }
+        pathsToSync.emplace_back(std::move(path), std::move(fileState));
+    }
+
+    changedFileStates = std::move(pathsToSync);
+    schedulePersist();
+}
+
+sdbusplus::async::task<
+    std::vector<std::pair<fs::path, std::optional<FileState>>>>
+    Manager::getChangedFileStates(const std::set<fs::path>& changedPaths) const
+{
+    std::vector<std::pair<fs::path, std::optional<FileState>>>
+        changedFileStates;
+    changedFileStates.reserve(changedPaths.size());
+    for (const auto& changedPath : changedPaths)
+    {
+        changedFileStates.emplace_back(
+            changedPath,
+            co_await _contentHashCache.getFileState(_ctx, changedPath));
+    }
+    co_return changedFileStates;
+}
+
+fs::path Manager::getDestPath(const fs::path& path) const
+{
+    return fs::path(_syncDestRoot) / path.relative_path();
+}
+
+sdbusplus::async::task<> Manager::persistContentHashCache()
+{
+    // Batch the updates of the syncs happening in a while into one write.
+    constexpr auto persistDelay = std::chrono::seconds(10);
+    co_await sdbusplus::async::sleep_for(_ctx, persistDelay);
+
+    _isCachePersistScheduled = false;
+    _contentHashCache.persist();
+    _versionStore.persist();
+}
+
+sdbusplus::async::task<> Manager::publishMetrics()
+{
+    while (!_ctx.stop_requested())
+    {
+        co_await sdbusplus::async::sleep_for(
+            _ctx, std::chrono::seconds(METRICS_PUBLISH_INTERVAL));
+
+        std::size_t queueDepth = 0;
+        for (const auto& syncQueue : _syncQueues)
+        {
+            queueDepth += syncQueue.size();
+        }
+        _syncMetrics.setQueueDepth(queueDepth);
+        _syncMetrics.setCoalescedEventCount(
+            _eventCoalescer.getCoalescedEventsCount());
+        _metricsServer->emitChanged();
+    }
+}
+
+sdbusplus::async::task<bool>
+    Manager::syncData(const std::vector<SyncRequest>& syncBatch,
+                      ActiveSync& activeSync)
+{
+    const auto& firstPath = syncBatch.front()._dataSyncCfg->_path;
+
+    // The temporaries of the sync are built in a pooled buffer rather than
+    // in the heap, which is released at once when the sync is done.
+    SyncArena syncArena(_syncBufferPool);
+    const auto pathsToSync = getPathsToSync(syncBatch, syncArena.get());
+
+    // The version of the bidirectional data is transferred by rsync as an
+    // extended attribute along with the data.
+    if (_isLocalCopyEnabled &&
+        std::ranges::none_of(syncBatch, [](const auto& syncRequest) {
+        return syncRequest._dataSyncCfg->_syncDirection ==
+               config::SyncDirection::Bidirectional;
+    }))
+    {
+        if (const auto paths = splitPathsToSync(pathsToSync);
+            canCopyLocally(paths))
+        {
+            // The copy blocks on the disk, hence it runs off the event loop.
+            bool isCopied = false;
+            co_await async::runInThread(_ctx, [this, &paths, &isCopied]() {
+                isCopied = copyLocally(paths);
+            });
+            co_return isCopied;
+        }
+    }
+
+    for (auto waitTime = timeToBandwidth(syncBatch);
+         waitTime > std::chrono::steady_clock::duration::zero();
+         waitTime = timeToBandwidth(syncBatch))
+    {
+        co_await sdbusplus::async::sleep_for(_ctx, waitTime);
+    }
+
+    // The global bandwidth is shared by the transfers running at the time
+    // this one starts.
+    const auto bandwidthLimit = getBandwidthLimit(
+        *syncBatch.front()._dataSyncCfg, _activeSyncs.size());
+    const auto transferStartTime = std::chrono::steady_clock::now();
+    const auto [exitStatus, output] = co_await async::execCmd(
+        _ctx, getSyncCmd(syncBatch.front()._syncOptions, bandwidthLimit),
+        pathsToSync, &activeSync._pid);
+
+    // The bytes are apportioned as per the size of the files of each data.
+    const auto sentBytes = getSentBytes(output);
+    std::vector<std::size_t> indices;
+    std::vector<std::uint64_t> weights;
+    for (const auto& syncRequest : syncBatch)
+    {
+        indices.push_back(getIndex(*syncRequest._dataSyncCfg));
+        weights.push_back(std::ranges::fold_left(
+            syncRequest._changedFileStates | std::views::values,
+            std::uint64_t{0}, [](std::uint64_t size, const auto& fileState) {
+            return size + (fileState.has_value() ? fileState->_size : 0);
+        }));
+    }
+    _syncMetrics.recordSentBytes(indices, weights, sentBytes);
+
+    // The interrupted and failed transfers used the bandwidth as well.
+    consumeBandwidth(syncBatch, utility::apportion(sentBytes, weights),
+                     sentBytes, transferStartTime);
+    DATA_SYNC_TRACE(sync_sent, firstPath.c_str(), sentBytes);
+
+    if (exitStatus != 0 && activeSync._isPreempted)
+    {
+        lg2::info("Interrupted the sync of the data : {PATH} (and {COUNT} "
+                  "more) to sync a higher priority data",
+                  "PATH", firstPath, "COUNT", syncBatch.size() - 1);
+        co_return false;
+    }
+
+    if (exitStatus != 0)
+    {
+        // TODO Create error log on failure
+        lg2::error("Failed to sync the data : {PATH} (and {COUNT} more), "
+                   "exit status : {EXIT_STATUS}, output : {OUTPUT}",
+                   "PATH", firstPath, "COUNT", syncBatch.size() - 1,
+                   "EXIT_STATUS", exitStatus, "OUTPUT", output);
+        co_return false;
+    }
+
+    lg2::debug("Synced the data : {PATH} (and {COUNT} more)", "PATH",
+               firstPath, "COUNT", syncBatch.size() - 1);
+    co_return true;
+}
+
+std::uint32_t
+    Manager::getBandwidthLimit(const config::DataSyncConfig& dataSyncCfg,
+                               std::size_t activeTransfersCount)
+{
+    const std::uint32_t dataLimit =
+        dataSyncCfg._bandwidthLimitInKBps.value_or(DEFAULT_BANDWIDTH_LIMIT);
+    const std::uint32_t globalLimit =
+        GLOBAL_BANDWIDTH_LIMIT == 0
+            ? 0
+            : std::max<std::uint32_t>(
+                  GLOBAL_BANDWIDTH_LIMIT /
+                      std::max<std::size_t>(activeTransfersCount, 1),
+                  1);
+
+    if (dataLimit == 0 || globalLimit == 0)
+    {
+        return std::max(dataLimit, globalLimit);
+    }
+    return std::min(dataLimit, globalLimit);
+}
+
+std::chrono::steady_clock::duration
+    Manager::timeToBandwidth(const std::vector<SyncRequest>& syncBatch)
+{
+    auto waitTime = _syncBandwidth.timeToAvailable();
+    for (const auto& syncRequest : syncBatch)
+    {
+        waitTime = std::max(
+            waitTime,
+            getDataSyncBandwidth(*syncRequest._dataSyncCfg).timeToAvailable());
+    }
+    return waitTime;
+}
+
+void Manager::consumeBandwidth(
+    const std::vector<SyncRequest>& syncBatch,
+    const std::vector<std::uint64_t>& sentBytesPerRequest,
+    std::uint64_t sentBytes,
+    std::chrono::steady_clock::time_point transferStartTime)
+{
+    _syncBandwidth.consume(sentBytes, transferStartTime);
+
+    for (std::size_t position = 0; position < syncBatch.size(); ++position)
+    {
+        getDataSyncBandwidth(*syncBatch[position]._dataSyncCfg)
+            .consume(sentBytesPerRequest[position], transferStartTime);
+    }
+}
+
+TokenBucket&
+    Manager::getDataSyncBandwidth(const config::DataSyncConfig& dataSyncCfg)
+{
+    const std::uint64_t ratePerSec =
+        std::uint64_t{dataSyncCfg._bandwidthLimitInKBps.value_or(
+            DEFAULT_BANDWIDTH_LIMIT)} *
+        1024;
+    return _dataSyncBandwidths
+        .try_emplace(dataSyncCfg._path, ratePerSec, ratePerSec)
+        .first->second;
+}
+
+bool Manager::isLocalDest(std::string_view syncDestRoot)
+{
+    return utility::parseRsyncDest(syncDestRoot)._kind ==
+           utility::RsyncDest::Kind::Local;
+}
+
+bool Manager::copyLocally(const std::vector<fs::path>& paths) const
+{
+    bool isCopied = true;
+    local_copy::AtomicApply atomicApply;
+    for (const auto& path : paths)
+    {
+        const auto dest = getDestPath(path);
+        std::error_code statusEc;
+        if (fs::symlink_status(path, statusEc).type() ==
+            fs::file_type::not_found)
+        {
+            atomicApply.stageRemoval(dest);
+        }
+        else if (const auto ec = atomicApply.stage(path, dest); ec)
+        {
+            lg2::error("Failed to copy the data : {PATH} to {DEST}, "
+                       "error : {ERROR}",
+                       "PATH", path, "DEST", dest, "ERROR", ec.message());
+            isCopied = false;
+        }
+    }
+
+    if (const auto ec = atomicApply.commit(); ec)
+    {
+        lg2::error("Failed to apply the data : {PATH} (and {COUNT} more), "
+                   "error : {ERROR}",
+                   "PATH", paths.front(), "COUNT", paths.size() - 1, "ERROR",
+                   ec.message());
+        isCopied = false;
+    }
+    return isCopied;
+}
+
+std::vector<std::string>
+    Manager::getSyncCmd(const std::vector<std::string>& syncOptions,
+                        std::uint32_t bandwidthLimit) const
+{
+    // Sync the list of paths given through the standard input (NUL
+    // separated) with their full path so that the data lands in the same
+    // path on the sibling BMC, and remove the data from the sibling BMC as
+    // well if it got removed locally. The received files are put in place
+    // together at the end of the transfer, and the partially received files
+    // are kept to resume their transfer if the sync gets interrupted.
+    std::vector<std::string> syncCmd{"rsync",
+                                     "--archive",
+                                     "--recursive",
+                                     "--relative",
+                                     "--from0",
+                                     "--files-from=-",
+                                     "--delete",
+                                     "--delete-missing-args",
+                                     "--delay-updates",
+                                     "--partial"};
+
+    std::ranges::copy(syncOptions, std::back_inserter(syncCmd));
+
+    // rsync reports the bytes sent to account them against the token
+    // buckets and in the metrics.
+    syncCmd.emplace_back("--stats");
+
+    // rsync paces the transfer itself at the limit.
+    if (bandwidthLimit != 0)
+    {
+        syncCmd.emplace_back("--bwlimit=" + std::to_string(bandwidthLimit));
+    }
+
+    // Reuse the connection to the sibling BMC rather than authenticating
+    // again for every transfer.
+    if (_peerConnection.has_value())
+    {
+        syncCmd.emplace_back(_peerConnection->getSyncOption());
+    }
+
+    syncCmd.emplace_back("/");
+    syncCmd.emplace_back(_syncDestRoot);
+
+    return syncCmd;
+}
+
+std::pmr::string
+    Manager::getPathsToSync(const std::vector<SyncRequest>& syncBatch,
+                            std::pmr::memory_resource* memoryResource) const
+{
+    auto forEachPathToSync = [&syncBatch](const auto& func) {
+        for (const auto& syncRequest : syncBatch)
+        {
+            const auto& dataSyncCfg = *syncRequest._dataSyncCfg;
+            for (const auto& changedPath :
+                 syncRequest._changedFileStates | std::views::keys)
+            {
+                if (dataSyncCfg._includeFileTrie.empty() ||
+                    dataSyncCfg._includeFileTrie.findLongestPrefix(
+                        changedPath) != nullptr)
+                {
+                    func(std::string_view(changedPath.native()));
+                    continue;
+                }
+
+                // Sync only the configured files of the changed directory.
+                std::error_code ec;
+                if (fs::is_directory(changedPath, ec))
+                {
+                    forEachIncludedPath(dataSyncCfg, changedPath, func);
+                    continue;
+                }
+
+                // The directory is removed, hence the included paths which
+                // were under it have to be removed from the destination as
+                // well.
+                for (const auto& includePath :
+                     dataSyncCfg._includeFileList.value())
+                {
+                    const auto relativePath =
+                        fs::path(includePath).lexically_relative(changedPath);
+                    if (!relativePath.empty() && *relativePath.begin() != "..")
+                    {
+                        func(std::string_view(includePath));
+                    }
+                }
+            }
+        }
+    };
+
+    // The list is sized up front to be built in a single allocation, as the
+    // arena doesn't reuse the memory left behind by growing the list.
+    std::size_t size = 0;
+    forEachPathToSync(
+        [&size](std::string_view path) { size += path.size() + 1; });
+
+    std::pmr::string pathsToSync(memoryResource);
+    pathsToSync.reserve(size);
+    forEachPathToSync([&pathsToSync](std::string_view path) {
+        pathsToSync.append(path).push_back('\0');
+    });
+    return pathsToSync;
+}
+
+std::vector<std::string> Manager::getSyncOptions(
+    const config::DataSyncConfig& dataSyncCfg,
+    const std::vector<std::pair<fs::path, std::optional<FileState>>>&
+        changedFileStates) const
+{
+    std::vector<std::string> syncOptions;
+
+    // Without the transfer mode, rsync transfers only the changed blocks
+    // when syncing to a remote and the whole file when syncing locally.
+    if (dataSyncCfg._transferMode.has_value())
+    {
+        switch (dataSyncCfg._transferMode.value())
+        {
+            case config::TransferMode::Whole:
+                syncOptions.emplace_back("--whole-file");
+                break;
+            case config::TransferMode::Delta:
+                syncOptions.emplace_back("--no-whole-file");
+                break;
+        }
+    }
+
+    if (dataSyncCfg._excludeFileList.has_value())
+    {
+        std::ranges::transform(dataSyncCfg._excludeFileList.value(),
+                               std::back_inserter(syncOptions),
+                               [](const auto& excludePath) {
+            return "--exclude=" + excludePath;
+        });
+    }
+
+    // The files which are already compressed are skipped by rsync as per
+    // their suffix, and the tiny files are not worth compressing.
+    const auto isTinyChange = std::ranges::all_of(
+        changedFileStates | std::views::keys, [](const auto& changedPath) {
+        std::error_code ec;
+        return fs::is_regular_file(changedPath, ec) &&
+               fs::file_size(changedPath, ec) < minCompressSize;
+    });
+    if (dataSyncCfg._compression.has_value() && !isTinyChange)
+    {
+        switch (dataSyncCfg._compression.value())
+        {
+            case config::Compression::None:
+                break;
+            case config::Compression::LZ4:
+                syncOptions.emplace_back("--compress");
+                syncOptions.emplace_back("--compress-choice=lz4");
+                break;
+            case config::Compression::Zstd:
+                syncOptions.emplace_back("--compress");
+                syncOptions.emplace_back("--compress-choice=zstd");
+                if (dataSyncCfg._compressionLevel.has_value())
+                {
+                    syncOptions.emplace_back(
+                        "--compress-level=" +
+                        std::to_string(dataSyncCfg._compressionLevel.value()));
+                }
+                break;
+        }
+    }
+
+    // Transfer the version of the data along with it, and keep the copy of
+    // the sibling BMC which gets overwritten so that the sibling BMC can
+    // bring it back if its copy wins over the transferred copy.
+    if (dataSyncCfg._syncDirection == config::SyncDirection::Bidirectional)
+    {
+        syncOptions.emplace_back("--xattrs");
+        syncOptions.emplace_back("--backup");
+        syncOptions.emplace_back(
+            "--backup-dir=" +
+            (_persistDir / "conflicts").string());
+    }
+
+    return syncOptions;
+}
 } // namespace data_sync
@@ -2,9 +2,40 @@
 
 #pragma once
 
+#include "buffer_pool.hpp"
+#include "content_hash_cache.hpp"
 #include "data_sync_config.hpp"
+#include "event_coalescer.hpp"
+#include "merkle_tree.hpp"
+#include "metrics_server.hpp"
+#include "path_trie.hpp"
+#include "peer_connection.hpp"
+#include "retry_scheduler.hpp"
+#include "sync_journal.hpp"
+#include "sync_metrics.hpp"
+#include "timer_wheel.hpp"
+#include "token_bucket.hpp"
+#include "version_vector.hpp"
 
+#include <sys/types.h>
+
+#include <sdbusplus/async.hpp>
+#include <xyz/openbmc_project/State/BMC/Redundancy/client.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <map>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace data_sync
@@ -31,9 +62,19 @@ class Manager
      * @brief The constructor parses the configuration, monitors the data, and
      *        synchronizes it.
      *
+     * @param[in] ctx - The async context
      * @param[in] dataSyncCfgDir - The data sync configuration directory
+     * @param[in] syncDestRoot - The destination root of the sibling BMC
+     *                           under which the data will be synced
+     * @param[in] persistDir - The directory to persist the sync state in
+     * @param[in] isLocalCopyAllowed - Whether the files may be copied to a
+     *                                 local destination root without rsync,
+     *                                 which is disallowed only to measure
+     *                                 the rsync transfers
      */
-    Manager(const fs::path& dataSyncCfgDir);
+    Manager(sdbusplus::async::context& ctx, const fs::path& dataSyncCfgDir,
+            const std::string& syncDestRoot, const fs::path& persistDir,
+            bool isLocalCopyAllowed = true);
 
   private:
     /**
@@ -44,13 +85,1003 @@ class Manager
      * @return NULL
      *
      * @note It will continue parsing all files even if one file fails to parse.
+     *       The configuration is loaded from the snapshot of the previous
+     *       start if the configuration files are not changed since then.
      */
     void parseConfiguration(const fs::path& dataSyncCfgDir);
 
+    /**
+     * @brief A helper API to index the configured paths of the data, and
+     *        size the states kept per data for the added data.
+     *
+     * @return NULL
+     */
+    void indexConfiguration();
+
+    /**
+     * @brief A helper API to watch the data sync configuration directory
+     *        and reload the configuration on every change.
+     *
+     * @param[in] dataSyncCfgDir - The data sync configuration directory
+     *
+     * @return NULL
+     */
+    sdbusplus::async::task<> monitorConfiguration(fs::path dataSyncCfgDir);
+
+    /**
+     * @brief A helper API to apply the changes of the data sync
+     *        configuration without restarting the syncs of the unchanged
+     *        data.
+     *
+     * @param[in] dataSyncCfgDir - The data sync configuration directory
+     *
+     * @return NULL
+     *
+     * @note The configuration is not reloaded if any file fails to parse.
+     *       The watchers and the timers of only the added, updated and
+     *       removed data are armed again, and the added and updated data is
+     *       synced once. The ongoing syncs of the updated data continue
+     *       with the updated config.
+     */
+    void reloadConfiguration(const fs::path& dataSyncCfgDir);
+
+    /**
+     * @brief A helper API to stop the watcher and the timer of the given
+     *        data whose config is updated or removed.
+     *
+     * @param[in] index - The position of the data in _dataSyncConfiguration
+     *
+     * @return NULL
+     */
+    void disarmData(std::size_t index);
+
+    /**
+     * @brief A helper API to get the data which owns the given path, that is
+     *        the data with the deepest configured path which is the same as
+     *        or a parent of the given path.
+     *
+     * @param[in] path - The path to look up
+     *
+     * @return The data sync config on success; otherwise, nullptr.
+     *
+     * @note The lookup cost depends only on the depth of the given path
+     *       and not on the number of configured data.
+     */
+    const config::DataSyncConfig*
+        getOwningDataSyncConfig(const fs::path& path) const;
+
+    /**
+     * @brief A helper API to get the index of the given data sync config.
+     *
+     * @param[in] dataSyncCfg - The data sync config in
+     *                          _dataSyncConfiguration
+     *
+     * @return The index of the data in _dataSyncConfiguration.
+     */
+    std::size_t getIndex(const config::DataSyncConfig& dataSyncCfg) const
+    {
+        return _dataSyncCfgPositions.find(&dataSyncCfg)->second;
+    }
+
+    /**
+     * @brief The redundancy role of a BMC.
+     */
+    using BMCRole =
+        sdbusplus::common::xyz::openbmc_project::state::bmc::Redundancy::Role;
+
+    /**
+     * @brief A helper API to get the redundancy role of this BMC and start
+     *        the sync events as per the role whenever it changes.
+     *
+     * @return NULL
+     *
+     * @note Nothing is synced till the role is known.
+     */
+    sdbusplus::async::task<> monitorBMCRole();
+
+    /**
+     * @brief A helper API to check whether this BMC is the source of the
+     *        given data as per its current role.
+     *
+     * @param[in] dataSyncCfg - The data sync config
+     *
+     * @return true if the data has to be synced from this BMC.
+     */
+    bool isSourcedByThisBMC(const config::DataSyncConfig& dataSyncCfg) const;
+
+    /**
+     * @brief A helper API to start the sync events for the configured data
+     *        of which this BMC is the source.
+     *
+     * @return NULL
+     *
+     * @note The watchers and the timers of the data which this BMC is no
+     *       longer the source of stop at their next event. The data which is
+     *       already being watched or timed is not armed again.
+     */
+    void startSyncEvents();
+
+    /**
+     * @brief A helper API to start watching the configured data of which
+     *        this BMC is the source and which is not being watched.
+     *
+     * @return NULL
+     */
+    void armDataWatchers();
+
+    /**
+     * @brief A helper API to schedule the periodic sync of the configured
+     *        data of which this BMC is the source and which is not timed.
+     *
+     * @return NULL
+     */
+    void armSyncTimers();
+
+    /**
+     * @brief The details of a data to sync which is waiting in the sync
+     *        queue.
+     */
+    struct SyncRequest
+    {
+        /**
+         * @brief The data sync config to sync.
+         */
+        const config::DataSyncConfig* _dataSyncCfg;
+
+        /**
+         * @brief The rsync options of the data, the requests with the same
+         *        options are synced in one transfer.
+         */
+        std::vector<std::string> _syncOptions;
+
+        /**
+         * @brief The changed paths to sync and their state.
+         */
+        std::vector<std::pair<fs::path, std::optional<FileState>>>
+            _changedFileStates;
+
+        /**
+         * @brief Whether the request is part of the full sync.
+         */
+        bool _isFullSync;
+
+        /**
+         * @brief The number of retries done for the request.
+         */
+        std::uint8_t _retryCount{0};
+
+        /**
+         * @brief Whether the request holds a slot of the retry scheduler,
+         *        which a retry takes only while its transfer runs.
+         */
+        bool _hasRetrySlot{false};
+
+        /**
+         * @brief The id of the request in the sync journal once its sync
+         *        is started.
+         */
+        std::optional<std::uint64_t> _journalId{};
+
+        /**
+         * @brief The time of the first change which the request syncs.
+         */
+        std::chrono::steady_clock::time_point _firstEventTime{
+            std::chrono::steady_clock::now()};
+
+        /**
+         * @brief The time at which the request is queued to sync.
+         */
+        std::chrono::steady_clock::time_point _queuedTime{};
+    };
+
+    /**
+     * @brief The details of a sync which is in progress.
+     */
+    struct ActiveSync
+    {
+        /**
+         * @brief The priority of the data being synced.
+         */
+        config::Priority _priority;
+
+        /**
+         * @brief The process id of the sync command; -1 if not running.
+         */
+        pid_t _pid{-1};
+
+        /**
+         * @brief Whether the sync is interrupted to make room for a higher
+         *        priority data.
+         */
+        bool _isPreempted{false};
+    };
+
+    /**
+     * @brief The hash trees of a periodic directory to find the changes
+     *        since its last sync.
+     */
+    struct MerkleTrees
+    {
+        /**
+         * @brief The current files of the directory as per the watcher.
+         */
+        MerkleTree _current;
+
+        /**
+         * @brief The files of the directory as of their last sync.
+         */
+        MerkleTree _synced;
+
+        /**
+         * @brief The paths changed since the last periodic sync started,
+         *        which a sync in progress may not have transferred.
+         */
+        std::set<fs::path> _changedPaths;
+    };
+
+    /**
+     * @brief A helper API to resume the syncs which were interrupted by the
+     *        previous stop of the service, as per the sync journal.
+     *
+     * @return NULL
+     *
+     * @note The interrupted syncs are queued ahead of the full sync.
+     */
+    void resumeInterruptedSyncs();
+
+    /**
+     * @brief A helper API to start the full sync of all configured data of
+     *        which this BMC is the source.
+     *
+     * @return NULL
+     *
+     * @note The data is synced through the sync queue, and hence batched
+     *       with a bounded number of transfers in parallel. Every path is
+     *       synced, including the ones unchanged since their last sync.
+     */
+    void startFullSync();
+
+    /**
+     * @brief A helper API to sync all data again when the sibling BMC comes
+     *        back, as it may have lost the data while it was away.
+     *
+     * @return NULL
+     */
+    void onPeerBack();
+
+    /**
+     * @brief A helper API to update and report the full sync progress.
+     *
+     * @param[in] isSynced - Whether an entry of the full sync is synced
+     *
+     * @return NULL
+     */
+    void updateFullSyncProgress(bool isSynced);
+
+    /**
+     * @brief A helper API to monitor the given data and trigger the sync
+     *        on every change.
+     *
+     * @param[in] dataSyncCfg - The data sync config to monitor
+     *
+     * @return NULL
+     *
+     * @note The changes of a periodic directory only update its current
+     *       hash tree, which the periodic sync reconciles.
+     */
+    sdbusplus::async::task<>
+        monitorDataToSync(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to drive the timer wheel and trigger the sync
+     *        of all periodic data which are due.
+     *
+     * @param[in] generation - The generation of the task, which stops once
+     *                         a newer task takes over
+     *
+     * @return NULL
+     *
+     * @note A single instance serves all periodic data and wakes up only
+     *       when some timer is due.
+     */
+    sdbusplus::async::task<> monitorTimerToSync(std::uint64_t generation);
+
+    /**
+     * @brief A helper API to update the given hash tree with the current
+     *        state of the given path of the given directory.
+     *
+     * @param[in] dataSyncCfg - The data sync config of the directory
+     * @param[in] path - The changed path under the directory
+     * @param[out] merkleTree - The hash tree to update
+     *
+     * @return NULL
+     *
+     * @note A directory is walked to add all the files under it.
+     */
+    void updateMerkleTree(const config::DataSyncConfig& dataSyncCfg,
+                          const fs::path& path, MerkleTree& merkleTree) const;
+
+    /**
+     * @brief A helper API to get the paths of the given periodic data to
+     *        sync.
+     *
+     * @param[in] dataSyncCfg - The data sync config of the periodic data
+     *
+     * @return The subtrees of a directory which changed since their last
+     *         sync; the configured path if none changed, if the directory
+     *         has no hash tree or for a file.
+     */
+    std::vector<fs::path>
+        getPeriodicPathsToSync(const config::DataSyncConfig& dataSyncCfg) const;
+
+    /**
+     * @brief A helper API to record the synced paths of the given request
+     *        in the synced hash tree of its directory.
+     *
+     * @param[in] syncRequest - The synced request
+     *
+     * @return NULL
+     *
+     * @note The paths changed after the start of the sync keep their
+     *       previous synced state to sync them again.
+     */
+    void updateSyncedMerkleTree(const SyncRequest& syncRequest);
+
+    /**
+     * @brief A helper API to get the ticks after which the given periodic
+     *        data has to be synced.
+     *
+     * @param[in] index - The position of the periodic data in
+     *                    _dataSyncConfiguration
+     * @param[in] isFirstSync - Whether it is the first sync after startup
+     *
+     * @return The ticks (in seconds) which includes the jitter to spread
+     *         the data with the same periodicity across ticks.
+     */
+    TimerWheel::Tick getTicksToNextSync(std::size_t index, bool isFirstSync);
+
+    /**
+     * @brief A helper API to wait for the changes of the given data to
+     *        settle and sync them until no change is pending.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     *
+     * @return NULL
+     *
+     * @note Only one instance runs per configured path, changes received
+     *       while syncing are synced once the ongoing sync is finished.
+     */
+    sdbusplus::async::task<>
+        coalesceAndSync(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to queue the given data to sync and start a sync
+     *        worker if the parallel sync limit is not reached.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     * @param[in] changedFileStates - The changed paths and their state
+     * @param[in] isFullSync - Whether the sync is part of the full sync
+     * @param[in] firstEventTime - The time of the first change to sync
+     *
+     * @return NULL
+     */
+    void enqueueSync(const config::DataSyncConfig& dataSyncCfg,
+                     std::vector<std::pair<fs::path, std::optional<FileState>>>
+                         changedFileStates,
+                     bool isFullSync,
+                     std::chrono::steady_clock::time_point firstEventTime);
+
+    /**
+     * @brief A helper API to queue the sync of the given paths, which are
+     *        claimed for the given data in the coalescer, once their state
+     *        is known.
+     *
+     * @param[in] dataSyncCfg - The data sync config to sync
+     * @param[in] claimedPaths - The paths to sync
+     * @param[in] isFullSync - Whether the sync is part of the full sync
+     * @param[in] firstEventTime - The time of the first change to sync
+     * @param[in] journalId - The id of the interrupted sync in the sync
+     *                        journal if the sync is resumed
+     *
+     * @return NULL
+     */
+    sdbusplus::async::task<> enqueueClaimedPaths(
+        const config::DataSyncConfig& dataSyncCfg,
+        std::set<fs::path> claimedPaths, bool isFullSync,
+        std::chrono::steady_clock::time_point firstEventTime,
+        std::optional<std::uint64_t> journalId = std::nullopt);
+
+    /**
+     * @brief A helper API to queue the given request to sync and start a
+     *        sync worker if the parallel sync limit is not reached.
+     *
+     * @param[in] syncRequest - The request to sync
+     *
+     * @return NULL
+     *
+     * @note A lower priority sync is interrupted if no worker is free for
+     *       a high priority request.
+     */
+    void submitSyncRequest(SyncRequest syncRequest);
+
+    /**
+     * @brief A helper API to schedule the retry of the given failed request
+     *        as per the retry details of the data.
+     *
+     * @param[in,out] syncRequest - The failed request, which is moved into
+     *                              the retry if scheduled
+     *
+     * @return true if the retry is scheduled; false if all the retry
+     *         attempts are done.
+     */
+    bool scheduleRetry(SyncRequest& syncRequest);
+
+    /**
+     * @brief A helper API to queue the given request again once the retry
+     *        delay is elapsed.
+     *
+     * @param[in] syncRequest - The request to retry
+     * @param[in] retryDelay - The time to wait before the retry
+     *
+     * @return NULL
+     */
+    sdbusplus::async::task<>
+        retrySync(SyncRequest syncRequest,
+                  RetryScheduler::Clock::duration retryDelay);
+
+    /**
+     * @brief A helper API to drop the given request, whose data is not
+     *        sourced by this BMC anymore (e.g. after a role change) or is
+     *        removed from the configuration.
+     *
+     * @param[in,out] syncRequest - The request to drop, whose retry slot
+     *                              and journal entry are given back
+     *
+     * @return NULL
+     *
+     * @note The path of the data is released without syncing the changes
+     *       which came meanwhile.
+     */
+    void dropSyncRequest(SyncRequest& syncRequest);
+
+    /**
+     * @brief A helper API to interrupt an ongoing sync of a lower priority
+     *        data to sync the given priority data without waiting.
+     *
+     * @param[in] priority - The priority of the data waiting to be synced
+     *
+     * @return NULL
+     *
+     * @note Only the high priority data interrupts, to not starve the low
+     *       priority data under the load of the normal priority data. The
+     *       interrupted data is synced again once a sync is free.
+     */
+    void preemptLowerPrioritySync(config::Priority priority);
+
+    /**
+     * @brief A helper API to check whether any data is waiting to be
+     *        synced.
+     *
+     * @return true if the sync queues are empty.
+     */
+    bool isSyncQueueEmpty() const;
+
+    /**
+     * @brief A helper API to take the next batch of requests to sync in
+     *        one transfer from the sync queue of the highest priority.
+     *
+     * @return The requests which share the same priority and sync options.
+     *
+     * @note The sync queues must not be empty.
+     */
+    std::vector<SyncRequest> takeSyncBatch();
+
+    /**
+     * @brief A helper API to run a sync worker, which drains the sync queue
+     *        and then gives back its slot.
+     *
+     * @return NULL
+     *
+     * @note The slot is given back even if the worker fails, and a new
+     *       worker takes over the queued data in that case.
+     */
+    sdbusplus::async::task<> runSyncWorker();
+
+    /**
+     * @brief A helper API to sync the queued requests batch by batch till
+     *        the sync queue is empty.
+     *
+     * @return NULL
+     */
+    sdbusplus::async::task<> drainSyncQueue();
+
+    /**
+     * @brief A helper API to sync the given batch of data to the sibling BMC
+     *        in one transfer.
+     *
+     * @param[in] syncBatch - The requests to sync, which share the same sync
+     *                        options
+     * @param[in,out] activeSync - The details of the sync to track it while
+     *                             in progress
+     *
+     * @return true if the data is synced successfully; false otherwise.
+     *
+     * @note The transfer waits till the bandwidth used by the previous
+     *       transfers is paid back if the bandwidth is limited.
+     */
+    sdbusplus::async::task<bool>
+        syncData(const std::vector<SyncRequest>& syncBatch,
+                 ActiveSync& activeSync);
+
+    /**
+     * @brief A helper API to get the current state of the given changed
+     *        paths to compare against the content hash cache.
+     *
+     * @param[in] changedPaths - The changed paths
+     *
+     * @return The changed paths and their state, where the state is nullopt
+     *         if the path is not a hashable regular file (e.g. directory or
+     *         removed file).
+     *
+     * @note The files are hashed in a thread, one at a time.
+     */
+    sdbusplus::async::task<
+        std::vector<std::pair<fs::path, std::optional<FileState>>>>
+        getChangedFileStates(const std::set<fs::path>& changedPaths) const;
+
+    /**
+     * @brief A helper API to get the destination of the given path on the
+     *        sibling BMC, which keys the path in the content hash cache.
+     *
+     * @param[in] path - The source path
+     *
+     * @return The destination in rsync format.
+     */
+    fs::path getDestPath(const fs::path& path) const;
+
+    /**
+     * @brief A helper API to record the state of the synced files in the
+     *        content hash cache and schedule the persist.
+     *
+     * @param[in] syncedFileStates - The synced paths and their state
+     *
+     * @return NULL
+     */
+    void updateContentHashCache(
+        const std::vector<std::pair<fs::path, std::optional<FileState>>>&
+            syncedFileStates);
+
+    /**
+     * @brief A helper API to schedule the persist of the content hash cache
+     *        and the version store if they are modified.
+     *
+     * @return NULL
+     */
+    void schedulePersist();
+
+    /**
+     * @brief A helper API to version the changed files of a bidirectional
+     *        data and resolve the conflicting changes made on both BMCs.
+     *
+     * @param[in,out] changedFileStates - The changed paths and their state,
+     *                                    from which the files received from
+     *                                    the sibling BMC are removed
+     *
+     * @return NULL
+     *
+     * @note A file whose version is the last known version is changed on
+     *       this BMC and its version is incremented. A file with a newer
+     *       version, or with a concurrent version which wins, is received
+     *       from the sibling BMC and isn't synced back. Otherwise, the copy
+     *       of this BMC which the transfer overwrote is brought back and
+     *       synced to the sibling BMC. The removal received from the sibling
+     *       BMC, which leaves the removed file in the backup dir, isn't
+     *       synced back either, and the backups are cleaned up once looked
+     *       at so that the backup dir doesn't grow.
+     */
+    sdbusplus::async::task<> resolveVersions(
+        std::vector<std::pair<fs::path, std::optional<FileState>>>&
+            changedFileStates);
+
+    /**
+     * @brief A helper API to persist the content hash cache after a while
+     *        to batch the updates of multiple syncs into one write.
+     *
+     * @return NULL
+     */
+    sdbusplus::async::task<> persistContentHashCache();
+
+    /**
+     * @brief A helper API to publish the changed sync metrics on D-Bus at a
+     *        fixed rate.
+     *
+     * @return NULL
+     *
+     * @note The changes in an interval are batched into one
+     *       PropertiesChanged signal per changed object.
+     */
+    sdbusplus::async::task<> publishMetrics();
+
+    /**
+     * @brief A helper API to get the bandwidth limit of one transfer of
+     *        the given data.
+     *
+     * @param[in] dataSyncCfg - The data sync config
+     * @param[in] activeTransfersCount - The transfers running together,
+     *                                   which share the global limit
+     *
+     * @return The bandwidth limit in KiB per second, which is the lower of
+     *         the data limit and the share of the global limit; zero if not
+     *         limited.
+     */
+    static std::uint32_t
+        getBandwidthLimit(const config::DataSyncConfig& dataSyncCfg,
+                          std::size_t activeTransfersCount);
+
+    /**
+     * @brief A helper API to get the time to wait for the bandwidth to be
+     *        available to sync the given batch.
+     *
+     * @param[in] syncBatch - The requests to sync
+     *
+     * @return The time to wait; zero if the batch can be synced right away.
+     */
+    std::chrono::steady_clock::duration
+        timeToBandwidth(const std::vector<SyncRequest>& syncBatch);
+
+    /**
+     * @brief A helper API to account the bytes sent to sync the given batch
+     *        against the global bandwidth and the bandwidth of each data in
+     *        the batch.
+     *
+     * @param[in] syncBatch - The synced requests
+     * @param[in] sentBytesPerRequest - The share of each request in the
+     *                                  bytes sent, in the batch order
+     * @param[in] sentBytes - The bytes sent by the transfer
+     * @param[in] transferStartTime - The time at which the transfer started
+     *
+     * @return NULL
+     *
+     * @note The bytes sent per data are not known for a batch, hence each
+     *       data is charged with its share as apportioned for the metrics,
+     *       while the global bandwidth is charged with the whole transfer.
+     */
+    void consumeBandwidth(
+        const std::vector<SyncRequest>& syncBatch,
+        const std::vector<std::uint64_t>& sentBytesPerRequest,
+        std::uint64_t sentBytes,
+        std::chrono::steady_clock::time_point transferStartTime);
+
+    /**
+     * @brief A helper API to get the token bucket of the given data, which
+     *        is created on the first use.
+     *
+     * @param[in] dataSyncCfg - The data sync config
+     *
+     * @return The token bucket of the data.
+     */
+    TokenBucket&
+        getDataSyncBandwidth(const config::DataSyncConfig& dataSyncCfg);
+
+    /**
+     * @brief A helper API to check whether the given rsync destination is
+     *        a local path, e.g. a directory shared with the sibling BMC.
+     *
+     * @param[in] syncDestRoot - The destination root in rsync format
+     *
+     * @return true if the destination is local; false if it is remote.
+     */
+    static bool isLocalDest(std::string_view syncDestRoot);
+
+    /**
+     * @brief A helper API to sync the given files to the local destination
+     *        without rsync.
+     *
+     * @param[in] paths - The files to sync, which are either a regular
+     *                    file or removed
+     *
+     * @return true if all the files are synced; false otherwise.
+     *
+     * @note The files are copied within the kernel instead of going through
+     *       the user space buffers of rsync, and applied together once all
+     *       of them are copied. It blocks till the files are on the disk,
+     *       hence it has to be run off the event loop.
+     */
+    bool copyLocally(const std::vector<fs::path>& paths) const;
+
+    /**
+     * @brief A helper API to frame the rsync command to sync the list of
+     *        paths given through the standard input.
+     *
+     * @param[in] syncOptions - The rsync options specific to the data
+     * @param[in] bandwidthLimit - The bandwidth limit of the transfer in
+     *                             KiB per second, zero if not limited
+     *
+     * @return The rsync command and its arguments
+     */
+    std::vector<std::string>
+        getSyncCmd(const std::vector<std::string>& syncOptions,
+                   std::uint32_t bandwidthLimit) const;
+
+    /**
+     * @brief A helper API to get the list of paths to sync for the given
+     *        batch in the rsync --files-from format.
+     *
+     * @param[in] syncBatch - The requests to sync
+     * @param[in] memoryResource - The memory to build the list in
+     *
+     * @return The NUL separated list of paths.
+     *
+     * @note The paths are gathered twice, first to size the list, so that
+     *       the list is allocated once from the memory.
+     */
+    std::pmr::string
+        getPathsToSync(const std::vector<SyncRequest>& syncBatch,
+                       std::pmr::memory_resource* memoryResource) const;
+
+    /**
+     * @brief A helper API to get the rsync options specific to the given
+     *        data, which decides whether the data can be batched together.
+     *
+     * @param[in] dataSyncCfg - The data sync config
+     * @param[in] changedFileStates - The changed paths to sync
+     *
+     * @return The rsync options
+     */
+    std::vector<std::string> getSyncOptions(
+        const config::DataSyncConfig& dataSyncCfg,
+        const std::vector<std::pair<fs::path, std::optional<FileState>>>&
+            changedFileStates) const;
+
+    /**
+     * @brief The minimum size of the changed files to compress while
+     *        transferring, below which the compression doesn't pay off.
+     */
+    static constexpr std::uintmax_t minCompressSize = 4096;
+
+    /**
+     * @brief The progress details of the full sync.
+     */
+    struct FullSyncProgress
+    {
+        /**
+         * @brief The number of entries to sync.
+         */
+        std::size_t _totalEntries{0};
+
+        /**
+         * @brief The number of entries synced successfully.
+         */
+        std::size_t _syncedEntries{0};
+
+        /**
+         * @brief The number of entries failed to sync.
+         */
+        std::size_t _failedEntries{0};
+
+        /**
+         * @brief The time at which the full sync is started.
+         */
+        std::chrono::steady_clock::time_point _startTime;
+    };
+
+    /**
+     * @brief The time to wait after a change of the configuration before
+     *        reloading it, to batch the changes of multiple files.
+     */
+    static constexpr auto configReloadDelay = std::chrono::seconds(1);
+
+    /**
+     * @brief The maximum number of paths to sync in one transfer.
+     */
+    static constexpr std::size_t maxPathsPerBatch = 256;
+
+    /**
+     * @brief The size of the arena of a sync, which fits the list of paths
+     *        of a full batch.
+     */
+    static constexpr std::size_t syncArenaSize = 32 * 1024;
+
+    /**
+     * @brief The async context object used to perform operations
+     *        asynchronously as required.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The destination root of the sibling BMC in rsync format.
+     */
+    std::string _syncDestRoot;
+
+    /**
+     * @brief The directory where the sync state is persisted.
+     */
+    fs::path _persistDir;
+
+    /**
+     * @brief Whether the files are copied to the destination root without
+     *        rsync, as it is a local path.
+     */
+    bool _isLocalCopyEnabled;
+
+    /**
+     * @brief The id of this BMC to version the changes made on this BMC.
+     */
+    std::string _bmcId;
+
     /**
      * @brief The list of data to synchronize.
+     *
+     * @note The data is never erased or moved, so that its position and
+     *       address stay valid across the reloads of the configuration. The
+     *       removed data is marked in _isDataRemoved instead.
+     */
+    std::deque<config::DataSyncConfig> _dataSyncConfiguration;
+
+    /**
+     * @brief The position of each data in _dataSyncConfiguration by its
+     *        address.
+     */
+    std::unordered_map<const config::DataSyncConfig*, std::size_t>
+        _dataSyncCfgPositions;
+
+    /**
+     * @brief Whether the data is removed from the configuration, by the
+     *        index of the data in _dataSyncConfiguration.
+     */
+    std::vector<bool> _isDataRemoved;
+
+    /**
+     * @brief The number of times the config of the data is updated or
+     *        removed, by the index of the data in _dataSyncConfiguration,
+     *        to stop the watchers of its previous config.
+     */
+    std::vector<std::uint64_t> _dataGenerations;
+
+    /**
+     * @brief The index of the configured paths to the position of the data
+     *        in _dataSyncConfiguration.
+     */
+    PathTrie<std::size_t> _dataSyncCfgIndex;
+
+    /**
+     * @brief The positions of the data in _dataSyncConfiguration grouped by
+     *        the sync type, so that arming the watchers and the timers
+     *        doesn't scan all the data.
+     */
+    std::array<std::vector<std::size_t>, 2> _indicesOfSyncType;
+
+    /**
+     * @brief The coalescer to collapse a burst of changes into one sync.
+     */
+    EventCoalescer _eventCoalescer;
+
+    /**
+     * @brief The queues of data waiting to be synced, one per priority in
+     *        the order of config::Priority.
+     */
+    std::array<std::deque<SyncRequest>, 3> _syncQueues;
+
+    /**
+     * @brief The syncs in progress.
+     */
+    std::vector<ActiveSync*> _activeSyncs;
+
+    /**
+     * @brief The number of sync workers which are running.
+     */
+    std::size_t _activeSyncWorkers{0};
+
+    /**
+     * @brief The progress of the full sync.
+     */
+    FullSyncProgress _fullSyncProgress;
+
+    /**
+     * @brief The content hash of the files at their last successful sync
+     *        to skip the sync if the content is not changed.
+     */
+    ContentHashCache _contentHashCache;
+
+    /**
+     * @brief The last known version of the bidirectional data.
+     */
+    VersionStore _versionStore;
+
+    /**
+     * @brief The journal of the syncs in progress to resume them after a
+     *        restart.
+     */
+    SyncJournal _syncJournal;
+
+    /**
+     * @brief Whether the content hash cache is scheduled to be persisted.
+     */
+    bool _isCachePersistScheduled{false};
+
+    /**
+     * @brief The timer wheel to schedule the periodic data sync, where the
+     *        timer id is the index of the data in _dataSyncConfiguration.
+     */
+    TimerWheel _periodicSyncTimers;
+
+    /**
+     * @brief The time of the tick 0 of the periodic sync timers.
+     */
+    const std::chrono::steady_clock::time_point _periodicSyncStartTime{
+        std::chrono::steady_clock::now()};
+
+    /**
+     * @brief The generation of the latest task driving the periodic sync
+     *        timers.
+     */
+    std::uint64_t _timerMonitorGeneration{0};
+
+    /**
+     * @brief The current redundancy role of this BMC.
+     */
+    BMCRole _bmcRole{BMCRole::Unknown};
+
+    /**
+     * @brief Whether the data is being watched, by the index of the data in
+     *        _dataSyncConfiguration.
+     */
+    std::vector<bool> _isDataWatched;
+
+    /**
+     * @brief Whether the periodic sync of the data is scheduled, by the
+     *        index of the data in _dataSyncConfiguration.
+     */
+    std::vector<bool> _isTimerScheduled;
+
+    /**
+     * @brief The sync counters of each data and of all data together.
+     */
+    SyncMetrics _syncMetrics{0};
+
+    /**
+     * @brief The D-Bus objects of the sync metrics.
+     */
+    std::optional<MetricsServer> _metricsServer;
+
+    /**
+     * @brief The connection shared by the transfers to the sibling BMC,
+     *        if the sync dest root is reached over SSH.
+     */
+    std::optional<PeerConnection> _peerConnection;
+
+    /**
+     * @brief The hash trees of the periodic directories by the configured
+     *        path.
+     */
+    std::map<std::string, MerkleTrees, std::less<>> _merkleTrees;
+
+    /**
+     * @brief The token bucket of all the sync traffic together.
+     */
+    TokenBucket _syncBandwidth;
+
+    /**
+     * @brief The token buckets of the data which are limited by their own
+     *        bandwidth limit, keyed on the configured path.
+     */
+    std::map<std::string, TokenBucket> _dataSyncBandwidths;
+
+    /**
+     * @brief The scheduler to back off and bound the retries of the failed
+     *        syncs.
+     */
+    RetryScheduler _retryScheduler;
+
+    /**
+     * @brief The buffers backing the arena of each sync in progress.
+     */
+    BufferPool _syncBufferPool;
+
+    /**
+     * @brief The random engine to jitter the periodic data sync.
      */
-    std::vector<config::DataSyncConfig> _dataSyncConfiguration;
+    std::minstd_rand _jitterEngine{std::random_device{}()};
 };
 
 } // namespace data_sync
@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "merkle_tree.hpp"
+
+#include "content_hash_cache.hpp"
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+namespace data_sync
+{
+
+namespace
+{
+
+/**
+ * @brief A helper API to append the bytes of the given hash.
+ */
+void appendHash(std::string& data, std::uint64_t hash)
+{
+    std::array<char, sizeof(hash)> bytes{};
+    std::memcpy(bytes.data(), &hash, sizeof(hash));
+    data.append(bytes.data(), bytes.size());
+}
+
+} // namespace
+
+MerkleTree::MerkleTree(fs::path root) :
+    _root(root.lexically_normal()), _rootNode(std::make_unique<Node>())
+{
+    // The directory may be configured with the trailing separator.
+    if (!_root.has_filename() && _root.has_relative_path())
+    {
+        _root = _root.parent_path();
+    }
+}
+
+MerkleTree::MerkleTree(const MerkleTree& other) :
+    _root(other._root), _rootNode(clone(*other._rootNode))
+{}
+
+MerkleTree& MerkleTree::operator=(const MerkleTree& other)
+{
+    if (this != &other)
+    {
+        _root = other._root;
+        _rootNode = clone(*other._rootNode);
+    }
+    return *this;
+}
+
+void MerkleTree::update(const fs::path& path,
+                        std::optional<std::uint64_t> leafHash)
+{
+    const auto relativePath = getRelativePath(path);
+    if (!relativePath.has_value())
+    {
+        return;
+    }
+
+    std::unique_ptr<Node> node;
+    if (leafHash.has_value())
+    {
+        node = std::make_unique<Node>();
+        node->_leafHash = leafHash;
+    }
+    place(relativePath.value(), std::move(node));
+}
+
+void MerkleTree::assign(const fs::path& path, const MerkleTree& other)
+{
+    const auto relativePath = getRelativePath(path);
+    if (!relativePath.has_value())
+    {
+        return;
+    }
+
+    const auto* otherNode = other.find(relativePath.value());
+    place(relativePath.value(),
+          otherNode != nullptr ? clone(*otherNode) : nullptr);
+}
+
+std::uint64_t MerkleTree::getRootHash() const
+{
+    return getHash(*_rootNode);
+}
+
+std::vector<fs::path> MerkleTree::diff(const MerkleTree& other) const
+{
+    std::vector<fs::path> diffPaths;
+    diff(_rootNode.get(), other._rootNode.get(), _root, diffPaths);
+    return diffPaths;
+}
+
+std::optional<fs::path> MerkleTree::getRelativePath(const fs::path& path) const
+{
+    auto relativePath = path.lexically_normal().lexically_relative(_root);
+    if (relativePath.empty() || *relativePath.begin() == "..")
+    {
+        return std::nullopt;
+    }
+    return relativePath;
+}
+
+const MerkleTree::Node* MerkleTree::find(const fs::path& relativePath) const
+{
+    const Node* node = _rootNode.get();
+    if (relativePath == ".")
+    {
+        return node;
+    }
+
+    for (const auto& name : relativePath)
+    {
+        const auto child = node->_children.find(name.native());
+        if (child == node->_children.end())
+        {
+            return nullptr;
+        }
+        node = child->second.get();
+    }
+    return node;
+}
+
+void MerkleTree::place(const fs::path& relativePath,
+                       std::unique_ptr<Node> node)
+{
+    if (relativePath == ".")
+    {
+        _rootNode = node != nullptr ? std::move(node)
+                                    : std::make_unique<Node>();
+        return;
+    }
+
+    // The directories along the path, with the name of the next entry.
+    std::vector<std::pair<Node*, std::string>> parents;
+    Node* dir = _rootNode.get();
+    const auto name = relativePath.filename().native();
+    for (const auto& dirName : relativePath.parent_path())
+    {
+        dir->_hash.reset();
+        auto child = dir->_children.find(dirName.native());
+        if (node == nullptr)
+        {
+            // Nothing to remove if the path is not in the tree.
+            if (child == dir->_children.end() ||
+                child->second->_leafHash.has_value())
+            {
+                return;
+            }
+        }
+        else if (child == dir->_children.end())
+        {
+            child = dir->_children
+                        .emplace(dirName.native(), std::make_unique<Node>())
+                        .first;
+        }
+        else
+        {
+            // A file is replaced by a directory.
+            child->second->_leafHash.reset();
+        }
+        parents.emplace_back(dir, dirName.native());
+        dir = child->second.get();
+    }
+    dir->_hash.reset();
+
+    if (node != nullptr)
+    {
+        dir->_children.insert_or_assign(name, std::move(node));
+        return;
+    }
+
+    dir->_children.erase(name);
+    for (auto parent = parents.rbegin(); parent != parents.rend(); ++parent)
+    {
+        auto& [parentDir, dirName] = *parent;
+        if (!parentDir->_children[dirName]->_children.empty())
+        {
+            break;
+        }
+        parentDir->_children.erase(dirName);
+    }
+}
+
+std::uint64_t MerkleTree::getHash(const Node& node)
+{
+    if (node._hash.has_value())
+    {
+        return node._hash.value();
+    }
+
+    std::string data;
+    if (node._leafHash.has_value())
+    {
+        data.push_back('f');
+        appendHash(data, node._leafHash.value());
+    }
+    else
+    {
+        data.push_back('d');
+        for (const auto& [name, child] : node._children)
+        {
+            data.append(name).push_back('\0');
+            appendHash(data, getHash(*child));
+        }
+    }
+
+    node._hash = ContentHashCache::hash(data);
+    return node._hash.value();
+}
+
+std::unique_ptr<MerkleTree::Node> MerkleTree::clone(const Node& node)
+{
+    auto copy = std::make_unique<Node>();
+    copy->_leafHash = node._leafHash;
+    copy->_hash = node._hash;
+    for (const auto& [name, child] : node._children)
+    {
+        copy->_children.emplace(name, clone(*child));
+    }
+    return copy;
+}
+
+void MerkleTree::diff(const Node* node, const Node* otherNode,
+                      const fs::path& path, std::vector<fs::path>& diffPaths)
+{
+    if (node == nullptr && otherNode == nullptr)
+    {
+        return;
+    }
+    if (node != nullptr && otherNode != nullptr &&
+        getHash(*node) == getHash(*otherNode))
+    {
+        return;
+    }
+    if (node == nullptr || otherNode == nullptr ||
+        node->_leafHash.has_value() || otherNode->_leafHash.has_value())
+    {
+        diffPaths.push_back(path);
+        return;
+    }
+
+    for (const auto& [name, child] : node->_children)
+    {
+        const auto otherChild = otherNode->_children.find(name);
+        diff(child.get(),
+             otherChild != otherNode->_children.end() ? otherChild->second.get()
+                                                      : nullptr,
+             path / name, diffPaths);
+    }
+    for (const auto& [name, otherChild] : otherNode->_children)
+    {
+        if (!node->_children.contains(name))
+        {
+            diff(nullptr, otherChild.get(), path / name, diffPaths);
+        }
+    }
+}
+
+} // namespace data_sync
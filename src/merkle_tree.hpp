@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class MerkleTree
+ *
+ * @brief This class keeps the hash tree of the files under a directory,
+ *        where the hash of a directory is computed from the names and the
+ *        hashes of its entries, so that two trees can be compared by the
+ *        root hash and the differences are found by descending only into
+ *        the subtrees whose hashes differ.
+ *
+ * @note The tree is updated incrementally per file and only the hashes of
+ *       the directories along the path of the updated file are recomputed,
+ *       lazily when the hash is needed. The empty directories are not kept.
+ */
+class MerkleTree
+{
+  public:
+    /**
+     * @brief The constructor
+     *
+     * @param[in] root - The directory of which the files are kept
+     */
+    explicit MerkleTree(fs::path root);
+
+    MerkleTree(const MerkleTree& other);
+    MerkleTree& operator=(const MerkleTree& other);
+    MerkleTree(MerkleTree&&) = default;
+    MerkleTree& operator=(MerkleTree&&) = default;
+    ~MerkleTree() = default;
+
+    /**
+     * @brief Add, update or remove the given path in the tree.
+     *
+     * @param[in] path - The path under the root directory
+     * @param[in] leafHash - The hash identifying the file content; nullopt
+     *                       to remove the path and all the files under it
+     *
+     * @return NULL
+     *
+     * @note The paths which are not under the root directory are ignored.
+     */
+    void update(const fs::path& path, std::optional<std::uint64_t> leafHash);
+
+    /**
+     * @brief Replace the given path in the tree with the same path of the
+     *        other tree.
+     *
+     * @param[in] path - The path under the root directory
+     * @param[in] other - The tree of the same root directory
+     *
+     * @return NULL
+     *
+     * @note The path is removed if it is not in the other tree.
+     */
+    void assign(const fs::path& path, const MerkleTree& other);
+
+    /**
+     * @brief Get the hash of the root directory.
+     *
+     * @return The root hash.
+     */
+    std::uint64_t getRootHash() const;
+
+    /**
+     * @brief Get the topmost paths which differ between this and the other
+     *        tree of the same root directory.
+     *
+     * @param[in] other - The tree to compare with
+     *
+     * @return The differing files and the directories which exist in only
+     *         one of the trees; empty if the root hashes match.
+     */
+    std::vector<fs::path> diff(const MerkleTree& other) const;
+
+  private:
+    /**
+     * @brief A file or directory in the tree.
+     */
+    struct Node
+    {
+        /**
+         * @brief The entries of the directory by name.
+         */
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> _children;
+
+        /**
+         * @brief The hash of the file content; nullopt for a directory.
+         */
+        std::optional<std::uint64_t> _leafHash;
+
+        /**
+         * @brief The computed hash of the node; nullopt if the node or any
+         *        of its entries is updated after computing.
+         */
+        mutable std::optional<std::uint64_t> _hash;
+    };
+
+    /**
+     * @brief A helper API to get the path relative to the root directory.
+     *
+     * @param[in] path - The path under the root directory
+     *
+     * @return The relative path; nullopt if the path is not under the root.
+     */
+    std::optional<fs::path> getRelativePath(const fs::path& path) const;
+
+    /**
+     * @brief A helper API to find the node of the given relative path.
+     *
+     * @param[in] relativePath - The path relative to the root directory
+     *
+     * @return The node; nullptr if the path is not in the tree.
+     */
+    const Node* find(const fs::path& relativePath) const;
+
+    /**
+     * @brief A helper API to replace the node of the given relative path,
+     *        where the directories along the path are created if needed and
+     *        their computed hashes are invalidated.
+     *
+     * @param[in] relativePath - The path relative to the root directory
+     * @param[in] node - The node to place; nullptr to remove the path
+     *
+     * @return NULL
+     */
+    void place(const fs::path& relativePath, std::unique_ptr<Node> node);
+
+    /**
+     * @brief A helper API to compute the hash of the given node.
+     */
+    static std::uint64_t getHash(const Node& node);
+
+    /**
+     * @brief A helper API to deep copy the given node.
+     */
+    static std::unique_ptr<Node> clone(const Node& node);
+
+    /**
+     * @brief A helper API to collect the topmost differing paths of the
+     *        given nodes.
+     */
+    static void diff(const Node* node, const Node* otherNode,
+                     const fs::path& path, std::vector<fs::path>& diffPaths);
+
+    /**
+     * @brief The directory of which the files are kept.
+     */
+    fs::path _root;
+
+    /**
+     * @brief The node of the root directory.
+     */
+    std::unique_ptr<Node> _rootNode;
+};
+
+} // namespace data_sync
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "metrics_server.hpp"
+
+#include <sdbusplus/message/native_types.hpp>
+#include <xyz/openbmc_project/DataSync/BMCData/common.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace data_sync
+{
+
+namespace
+{
+
+/**
+ * @brief A helper API to get the D-Bus object path of the metrics of all
+ *        data together, under which the metrics of each data are hosted.
+ *
+ * @return The object path.
+ */
+sdbusplus::message::object_path getMetricsPath()
+{
+    using BMCDataSync =
+        sdbusplus::common::xyz::openbmc_project::data_sync::BMCData;
+    return sdbusplus::message::object_path(BMCDataSync::namespace_path) /
+           "metrics";
+}
+
+} // namespace
+
+MetricsServer::MetricsServer(sdbusplus::bus_t& bus,
+                             SyncMetrics& syncMetrics) :
+    _bus(bus), _syncMetrics(syncMetrics),
+    _objectManager(bus, getMetricsPath().str.c_str())
+{
+    _totalObject = std::make_unique<MetricsObject>(
+        _bus, getMetricsPath().str.c_str(),
+        MetricsObject::action::defer_emit);
+    setCounters(*_totalObject, _syncMetrics.getTotalCounters(), true);
+    setTotalMetrics(true);
+    _totalObject->emit_object_added();
+}
+
+void MetricsServer::addEntry(std::size_t index, const std::string& dataPath)
+{
+    if (_entryObjects.size() < index + 1)
+    {
+        _entryObjects.resize(index + 1);
+    }
+
+    // The interface can't be added again on the same object path.
+    _entryObjects[index].reset();
+    auto object = std::make_unique<MetricsObject>(
+        _bus, (getMetricsPath() / dataPath).str.c_str(),
+        MetricsObject::action::defer_emit);
+    object->path(dataPath, true);
+    setCounters(*object, _syncMetrics.getCounters(index), true);
+    object->emit_object_added();
+    _entryObjects[index] = std::move(object);
+}
+
+void MetricsServer::removeEntry(std::size_t index)
+{
+    if (index < _entryObjects.size())
+    {
+        _entryObjects[index].reset();
+    }
+}
+
+void MetricsServer::emitChanged()
+{
+    for (const auto index : _syncMetrics.takeChangedEntries())
+    {
+        if (index < _entryObjects.size() && _entryObjects[index])
+        {
+            setCounters(*_entryObjects[index], _syncMetrics.getCounters(index),
+                        false);
+        }
+    }
+    if (_syncMetrics.takeTotalChanged())
+    {
+        setCounters(*_totalObject, _syncMetrics.getTotalCounters(), false);
+        setTotalMetrics(false);
+    }
+}
+
+void MetricsServer::setCounters(MetricsIface& object,
+                                const SyncCounters& counters, bool skipSignal)
+{
+    object.syncCount(counters._syncCount, skipSignal);
+    object.failedSyncCount(counters._failedSyncCount, skipSignal);
+    object.retryCount(counters._retryCount, skipSignal);
+    object.sentBytes(counters._sentBytes, skipSignal);
+    object.lastSyncLatencyInMsec(counters._lastSyncLatencyInMsec, skipSignal);
+}
+
+void MetricsServer::setTotalMetrics(bool skipSignal)
+{
+    std::map<std::string, std::vector<std::uint64_t>> stageLatencies;
+    for (std::size_t stage = 0; stage < syncStagesCount; ++stage)
+    {
+        const auto syncStage = static_cast<SyncStage>(stage);
+        const auto& counts =
+            _syncMetrics.getStageLatencies(syncStage).getCounts();
+        stageLatencies.emplace(getSyncStageInStr(syncStage),
+                               std::vector<std::uint64_t>(counts.begin(),
+                                                          counts.end()));
+    }
+
+    _totalObject->queueDepth(_syncMetrics.getQueueDepth(), skipSignal);
+    _totalObject->coalescedEventCount(_syncMetrics.getCoalescedEventCount(),
+                                      skipSignal);
+    _totalObject->stageLatencies(std::move(stageLatencies), skipSignal);
+}
+
+} // namespace data_sync
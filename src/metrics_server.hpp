@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "sync_metrics.hpp"
+
+#include <sdbusplus/bus.hpp>
+#include <sdbusplus/server/manager.hpp>
+#include <sdbusplus/server/object.hpp>
+#include <xyz/openbmc_project/DataSync/Metrics/server.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace data_sync
+{
+
+/**
+ * @class MetricsServer
+ *
+ * @brief This class hosts the sync metrics on D-Bus, an object for all data
+ *        together and an object under it for each configured data.
+ *
+ * @note The properties are updated from the sync metrics only when asked,
+ *       for the objects whose counters changed since the previous update,
+ *       which emits the PropertiesChanged signals. The objects are added
+ *       along with their InterfacesAdded signal once their properties are
+ *       set.
+ */
+class MetricsServer
+{
+  public:
+    using MetricsIface =
+        sdbusplus::server::xyz::openbmc_project::data_sync::Metrics;
+    using MetricsObject = sdbusplus::server::object_t<MetricsIface>;
+
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+    MetricsServer(MetricsServer&&) = delete;
+    MetricsServer& operator=(MetricsServer&&) = delete;
+    ~MetricsServer() = default;
+
+    /**
+     * @brief The constructor adds the metrics object of all data together
+     *        on the given bus.
+     *
+     * @param[in] bus - The D-Bus connection
+     * @param[in] syncMetrics - The sync metrics to host
+     */
+    MetricsServer(sdbusplus::bus_t& bus, SyncMetrics& syncMetrics);
+
+    /**
+     * @brief Add the metrics object of the given data.
+     *
+     * @param[in] index - The index of the data in the sync metrics
+     * @param[in] dataPath - The configured path of the data
+     *
+     * @return NULL
+     */
+    void addEntry(std::size_t index, const std::string& dataPath);
+
+    /**
+     * @brief Remove the metrics object of the given data.
+     *
+     * @param[in] index - The index of the data in the sync metrics
+     *
+     * @return NULL
+     */
+    void removeEntry(std::size_t index);
+
+    /**
+     * @brief Update the properties of each object whose counters changed
+     *        since the previous update.
+     *
+     * @return NULL
+     */
+    void emitChanged();
+
+  private:
+    /**
+     * @brief A helper API to set the counters of the given object.
+     *
+     * @param[in] object - The metrics object
+     * @param[in] counters - The counters to set
+     * @param[in] skipSignal - Whether to skip the PropertiesChanged signal,
+     *                         i.e. while the object is not added yet
+     *
+     * @return NULL
+     */
+    static void setCounters(MetricsIface& object, const SyncCounters& counters,
+                            bool skipSignal);
+
+    /**
+     * @brief A helper API to set the gauges and the stage latencies of the
+     *        object of all data together.
+     *
+     * @param[in] skipSignal - Whether to skip the PropertiesChanged signal
+     *
+     * @return NULL
+     */
+    void setTotalMetrics(bool skipSignal);
+
+    /**
+     * @brief The D-Bus connection.
+     */
+    sdbusplus::bus_t& _bus;
+
+    /**
+     * @brief The sync metrics to host.
+     */
+    SyncMetrics& _syncMetrics;
+
+    /**
+     * @brief The object manager of the metrics objects, which emits the
+     *        InterfacesAdded and the InterfacesRemoved signals.
+     */
+    sdbusplus::server::manager_t _objectManager;
+
+    /**
+     * @brief The object of all data together.
+     */
+    std::unique_ptr<MetricsObject> _totalObject;
+
+    /**
+     * @brief The object of each data in the order of their indices, which is
+     *        null for a data removed from the configuration.
+     */
+    std::vector<std::unique_ptr<MetricsObject>> _entryObjects;
+};
+
+} // namespace data_sync
@@ -0,0 +1,279 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <fnmatch.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class PathTrie
+ *
+ * @brief A trie of path components to look up the paths against a set of
+ *        path patterns in O(depth of the path) regardless of the number of
+ *        patterns.
+ *
+ * @note A pattern component can be a glob (e.g. "*.json", "host?") which
+ *       matches exactly one component of the path as per fnmatch(3).
+ *
+ * @tparam Value - The value associated with each pattern
+ */
+template <typename Value>
+class PathTrie
+{
+  public:
+    /**
+     * @brief Add the given pattern into the trie.
+     *
+     * @param[in] pattern - The absolute path pattern
+     * @param[in] value - The value to associate with the pattern
+     *
+     * @note The value of the same pattern added again is overwritten.
+     */
+    void insert(const fs::path& pattern, Value value)
+    {
+        auto* node = &_root;
+        for (const auto& component : getComponents(pattern))
+        {
+            auto& children = isGlob(component) ? node->_globChildren
+                                               : node->_children;
+            auto& child = children[component];
+            if (!child)
+            {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+        }
+        node->_value = std::move(value);
+        _isEmpty = false;
+    }
+
+    /**
+     * @brief Add the given path into the trie as is, where the glob special
+     *        characters match only themselves.
+     *
+     * @param[in] path - The absolute path
+     * @param[in] value - The value to associate with the path
+     *
+     * @return true if added; false if the path is already added, in which
+     *         case its value is kept.
+     */
+    bool insertLiteral(const fs::path& path, Value value)
+    {
+        auto* node = &_root;
+        for (const auto& component : getComponents(path))
+        {
+            auto& child = node->_children[component];
+            if (!child)
+            {
+                child = std::make_unique<Node>();
+            }
+            node = child.get();
+        }
+        if (node->_value.has_value())
+        {
+            return false;
+        }
+        node->_value = std::move(value);
+        _isEmpty = false;
+        return true;
+    }
+
+    /**
+     * @brief Find the value of the deepest pattern which matches the given
+     *        path or one of its parents.
+     *
+     * @param[in] path - The absolute path to look up
+     *
+     * @return The pointer to the value of the matching pattern; nullptr if
+     *         no pattern matches.
+     */
+    const Value* findLongestPrefix(const fs::path& path) const
+    {
+        const auto components = getComponents(path);
+        const Value* bestValue = nullptr;
+        std::size_t bestDepth = 0;
+        findLongestPrefix(_root, components, 0, bestValue, bestDepth);
+        return bestValue;
+    }
+
+    /**
+     * @brief Check whether the given path is the same as or a parent of
+     *        any pattern.
+     *
+     * @param[in] path - The absolute path to look up
+     *
+     * @return true if some pattern lies at or under the given path.
+     */
+    bool hasPatternUnder(const fs::path& path) const
+    {
+        const auto components = getComponents(path);
+        return hasPatternUnder(_root, components, 0);
+    }
+
+    /**
+     * @brief Check whether any pattern is added.
+     *
+     * @return true if the trie is empty.
+     */
+    bool empty() const
+    {
+        return _isEmpty;
+    }
+
+  private:
+    /**
+     * @brief A node of the trie which represents a path component.
+     */
+    struct Node
+    {
+        /**
+         * @brief The value if a pattern ends at this node.
+         */
+        std::optional<Value> _value;
+
+        /**
+         * @brief The children with the literal path components.
+         */
+        std::map<std::string, std::unique_ptr<Node>, std::less<>> _children;
+
+        /**
+         * @brief The children with the glob path components.
+         */
+        std::map<std::string, std::unique_ptr<Node>, std::less<>>
+            _globChildren;
+    };
+
+    using Components = std::vector<std::string>;
+
+    /**
+     * @brief A helper API to split the given path into its components by
+     *        dropping the root and the empty components.
+     *
+     * @param[in] path - The path to split
+     *
+     * @return The path components.
+     */
+    static Components getComponents(const fs::path& path)
+    {
+        Components components;
+        for (const auto& component : path.lexically_normal().relative_path())
+        {
+            if (!component.empty() && component != ".")
+            {
+                components.emplace_back(component.string());
+            }
+        }
+        return components;
+    }
+
+    /**
+     * @brief A helper API to check whether the given component is a glob.
+     *
+     * @param[in] component - The path component
+     *
+     * @return true if the component has any glob special characters.
+     */
+    static bool isGlob(const std::string& component)
+    {
+        return component.find_first_of("*?[") != std::string::npos;
+    }
+
+    /**
+     * @brief A helper API to get the children of the given node which match
+     *        the given path component.
+     *
+     * @param[in] node - The trie node
+     * @param[in] component - The path component
+     * @param[in] visit - The callable to invoke with every matching child,
+     *                    which returns true to stop visiting.
+     *
+     * @return true if the visit is stopped.
+     */
+    template <typename Visitor>
+    static bool forEachMatchingChild(const Node& node,
+                                     const std::string& component,
+                                     Visitor&& visit)
+    {
+        if (auto childIt = node._children.find(component);
+            childIt != node._children.end() && visit(*childIt->second))
+        {
+            return true;
+        }
+        for (const auto& [glob, child] : node._globChildren)
+        {
+            if (fnmatch(glob.c_str(), component.c_str(), FNM_PERIOD) == 0 &&
+                visit(*child))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief A helper API to find the deepest pattern matching the given
+     *        path from the given node.
+     */
+    static void findLongestPrefix(const Node& node,
+                                  const Components& components,
+                                  std::size_t depth, const Value*& bestValue,
+                                  std::size_t& bestDepth)
+    {
+        if (node._value.has_value() &&
+            (bestValue == nullptr || depth > bestDepth))
+        {
+            bestValue = &node._value.value();
+            bestDepth = depth;
+        }
+        if (depth == components.size())
+        {
+            return;
+        }
+        forEachMatchingChild(node, components[depth], [&](const Node& child) {
+            findLongestPrefix(child, components, depth + 1, bestValue,
+                              bestDepth);
+            return false;
+        });
+    }
+
+    /**
+     * @brief A helper API to check whether the given path leads to some
+     *        pattern from the given node.
+     */
+    static bool hasPatternUnder(const Node& node, const Components& components,
+                                std::size_t depth)
+    {
+        if (depth == components.size())
+        {
+            return true;
+        }
+        return forEachMatchingChild(
+            node, components[depth], [&](const Node& child) {
+            return hasPatternUnder(child, components, depth + 1);
+        });
+    }
+
+    /**
+     * @brief The root node which represents "/".
+     */
+    Node _root;
+
+    /**
+     * @brief Whether no pattern is added.
+     */
+    bool _isEmpty{true};
+};
+
+} // namespace data_sync
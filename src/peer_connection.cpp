@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "peer_connection.hpp"
+
+#include "async_command_exec.hpp"
+#include "utility.hpp"
+
+#include <signal.h>
+
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace data_sync
+{
+
+bool PeerPresence::setUp()
+{
+    if (_isUp)
+    {
+        return false;
+    }
+    _isUp = true;
+    return std::exchange(_wasDown, false);
+}
+
+void PeerPresence::setDown()
+{
+    _isUp = false;
+    _wasDown = true;
+}
+
+PeerConnection::PeerConnection(sdbusplus::async::context& ctx,
+                               std::string remoteHost, fs::path controlPath,
+                               std::function<void()> onPeerBack) :
+    _ctx(ctx), _remoteHost(std::move(remoteHost)),
+    _controlPath(std::move(controlPath)), _onPeerBack(std::move(onPeerBack))
+{}
+
+PeerConnection::~PeerConnection()
+{
+    if (_pid != -1)
+    {
+        kill(_pid, SIGTERM);
+    }
+}
+
+std::optional<std::string>
+    PeerConnection::getRemoteHost(std::string_view syncDestRoot)
+{
+    auto rsyncDest = utility::parseRsyncDest(syncDestRoot);
+    if (rsyncDest._kind != utility::RsyncDest::Kind::Shell)
+    {
+        return std::nullopt;
+    }
+    return std::move(rsyncDest._remoteHost);
+}
+
+std::string PeerConnection::getSyncOption() const
+{
+    // The transfer falls back to its own connection if the shared one is
+    // not up, and never takes over as the shared one.
+    return "--rsh=ssh -o ControlMaster=no -o ControlPath=" +
+           _controlPath.string();
+}
+
+sdbusplus::async::task<> PeerConnection::run()
+{
+    std::chrono::seconds reconnectDelay = minReconnectDelay;
+    while (!_ctx.stop_requested())
+    {
+        // The socket left behind by an earlier run keeps the new connection
+        // from being shared.
+        std::error_code ec;
+        fs::remove(_controlPath, ec);
+
+        // The client stays in the foreground without running any command,
+        // and detects the sibling BMC going away through the keepalives.
+        const auto connectTime = Clock::now();
+        _ctx.spawn(detectConnectionUp(++_connectAttempt));
+        const auto [exitStatus, output] = co_await async::execCmd(
+            _ctx,
+            {"ssh", "-M", "-N", "-S", _controlPath.string(), "-o",
+             "ControlPersist=no", "-o", "BatchMode=yes", "-o",
+             "ServerAliveInterval=10", "-o", "ServerAliveCountMax=3",
+             _remoteHost},
+            {}, &_pid);
+        ++_connectAttempt;
+        if (_ctx.stop_requested())
+        {
+            break;
+        }
+        _presence.setDown();
+
+        // Back off only if the connection keeps getting closed soon.
+        if (Clock::now() - connectTime >= maxReconnectDelay)
+        {
+            reconnectDelay = minReconnectDelay;
+        }
+        lg2::warning("The connection to the sibling BMC : {HOST} is closed, "
+                     "exit status : {EXIT_STATUS}, output : {OUTPUT}, "
+                     "reconnecting in {DELAY}s",
+                     "HOST", _remoteHost, "EXIT_STATUS", exitStatus, "OUTPUT",
+                     output, "DELAY", reconnectDelay.count());
+
+        co_await sdbusplus::async::sleep_for(_ctx, reconnectDelay);
+        reconnectDelay = std::min<std::chrono::seconds>(reconnectDelay * 2,
+                                                        maxReconnectDelay);
+    }
+}
+
+sdbusplus::async::task<> PeerConnection::detectConnectionUp(
+    std::uint64_t attempt)
+{
+    while (attempt == _connectAttempt && !_ctx.stop_requested())
+    {
+        std::error_code ec;
+        if (fs::exists(_controlPath, ec))
+        {
+            if (_presence.setUp())
+            {
+                lg2::info("The sibling BMC : {HOST} is back", "HOST",
+                          _remoteHost);
+                if (_onPeerBack)
+                {
+                    _onPeerBack();
+                }
+            }
+            co_return;
+        }
+        co_await sdbusplus::async::sleep_for(_ctx, connectCheckInterval);
+    }
+}
+
+} // namespace data_sync
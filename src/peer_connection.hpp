@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <sdbusplus/async.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class PeerPresence
+ *
+ * @brief This class tracks whether the sibling BMC is reachable over the
+ *        connection, to tell when it comes back after being away.
+ *
+ * @note The sibling BMC is taken as present at the start, as the full sync
+ *       at the start covers it.
+ */
+class PeerPresence
+{
+  public:
+    /**
+     * @brief Record the connection coming up.
+     *
+     * @return true if the sibling BMC comes back, i.e. the connection was
+     *         closed or failed to come up since the last time it was up or
+     *         since the start; false otherwise.
+     */
+    bool setUp();
+
+    /**
+     * @brief Record the connection being closed or failing to come up.
+     *
+     * @return NULL
+     */
+    void setDown();
+
+    /**
+     * @brief Check whether the connection is up.
+     *
+     * @return true if up; false otherwise.
+     */
+    bool isUp() const
+    {
+        return _isUp;
+    }
+
+  private:
+    /**
+     * @brief Whether the connection is up.
+     */
+    bool _isUp{false};
+
+    /**
+     * @brief Whether the connection went down since it was last up.
+     */
+    bool _wasDown{false};
+};
+
+/**
+ * @class PeerConnection
+ *
+ * @brief This class keeps a single authenticated SSH connection to the
+ *        sibling BMC open, over which all the rsync transfers to a remote
+ *        sync dest root are multiplexed instead of connecting afresh for
+ *        every transfer.
+ *
+ * @note The connection is an OpenSSH control master, where each transfer
+ *       runs in its own channel with its own flow control, so the parallel
+ *       transfers share the connection without blocking each other. The
+ *       transfers connect on their own while the connection is down, and
+ *       the connection is brought back with a backoff.
+ */
+class PeerConnection
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    PeerConnection(const PeerConnection&) = delete;
+    PeerConnection& operator=(const PeerConnection&) = delete;
+    PeerConnection(PeerConnection&&) = delete;
+    PeerConnection& operator=(PeerConnection&&) = delete;
+
+    /**
+     * @brief The destructor closes the connection.
+     */
+    ~PeerConnection();
+
+    /**
+     * @brief The constructor
+     *
+     * @param[in] ctx - The async context to maintain the connection on
+     * @param[in] remoteHost - The [user@]host of the sibling BMC
+     * @param[in] controlPath - The socket through which the transfers
+     *                          share the connection
+     * @param[in] onPeerBack - The callback to invoke when the sibling BMC
+     *                         comes back, e.g. to sync all data to it again
+     */
+    PeerConnection(sdbusplus::async::context& ctx, std::string remoteHost,
+                   fs::path controlPath,
+                   std::function<void()> onPeerBack = {});
+
+    /**
+     * @brief Get the [user@]host of the given rsync destination, which is
+     *        reached over SSH.
+     *
+     * @param[in] syncDestRoot - The destination root in rsync format
+     *
+     * @return The [user@]host, without the brackets around an IPv6
+     *         address; nullopt if the destination is local or an rsync
+     *         daemon, which are not reached over SSH.
+     */
+    static std::optional<std::string>
+        getRemoteHost(std::string_view syncDestRoot);
+
+    /**
+     * @brief Get the rsync option to run the transfer over the connection.
+     *
+     * @return The rsync --rsh option.
+     */
+    std::string getSyncOption() const;
+
+    /**
+     * @brief Keep the connection open till the async context is stopped.
+     *
+     * @return NULL
+     */
+    sdbusplus::async::task<> run();
+
+  private:
+    /**
+     * @brief Wait for the given connection attempt to come up, and notify
+     *        if the sibling BMC comes back with it.
+     *
+     * @param[in] attempt - The connection attempt to wait for
+     *
+     * @return NULL
+     *
+     * @note The SSH client creates the control socket only once it is
+     *       authenticated to the sibling BMC, hence the socket tells that
+     *       the connection is up. The wait ends with the attempt.
+     */
+    sdbusplus::async::task<> detectConnectionUp(std::uint64_t attempt);
+
+    /**
+     * @brief The interval to check whether a connection attempt is up.
+     */
+    static constexpr auto connectCheckInterval =
+        std::chrono::milliseconds(500);
+
+    /**
+     * @brief The minimum time to wait before connecting again.
+     */
+    static constexpr auto minReconnectDelay = std::chrono::seconds(1);
+
+    /**
+     * @brief The maximum time to wait before connecting again.
+     */
+    static constexpr auto maxReconnectDelay = std::chrono::seconds(60);
+
+    /**
+     * @brief The async context.
+     */
+    sdbusplus::async::context& _ctx;
+
+    /**
+     * @brief The [user@]host of the sibling BMC.
+     */
+    std::string _remoteHost;
+
+    /**
+     * @brief The socket of the connection.
+     */
+    fs::path _controlPath;
+
+    /**
+     * @brief The callback to invoke when the sibling BMC comes back.
+     */
+    std::function<void()> _onPeerBack;
+
+    /**
+     * @brief The process id of the SSH client holding the connection;
+     *        -1 while not connected.
+     */
+    pid_t _pid{-1};
+
+    /**
+     * @brief The current connection attempt, bumped as each attempt starts
+     *        and ends.
+     */
+    std::uint64_t _connectAttempt{0};
+
+    /**
+     * @brief Whether the sibling BMC is reachable over the connection.
+     */
+    PeerPresence _presence;
+};
+
+} // namespace data_sync
@@ -17,7 +17,8 @@ int main()
     sdbusplus::async::context ctx;
     sdbusplus::server::manager_t objManager{ctx, BMCDataSync::namespace_path};
 
-    data_sync::Manager manager{DATA_SYNC_CONFIG_DIR};
+    data_sync::Manager manager{ctx, DATA_SYNC_CONFIG_DIR, SIBLING_BMC_DEST,
+                               DATA_SYNC_PERSIST_DIR};
 
     // clang-tidy currently mangles this into something unreadable
     // NOLINTNEXTLINE
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "retry_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace data_sync
+{
+
+RetryScheduler::RetryScheduler(std::size_t maxParallelRetries) :
+    _maxParallelRetries(std::max<std::size_t>(maxParallelRetries, 1))
+{}
+
+std::optional<RetryScheduler::Clock::duration>
+    RetryScheduler::getRetryDelay(const config::Retry& retry,
+                                  std::uint8_t retryCount,
+                                  std::minstd_rand& engine)
+{
+    if (retryCount >= retry._retryAttempts)
+    {
+        return std::nullopt;
+    }
+
+    const auto shift = std::min<unsigned>(retryCount, maxBackoffShift);
+    const auto backoff =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            retry._retryIntervalInSec) *
+        (1U << shift);
+
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+        0, backoff.count() / 2);
+    return backoff - std::chrono::milliseconds(jitter(engine));
+}
+
+bool RetryScheduler::tryAcquire()
+{
+    if (_activeRetries >= _maxParallelRetries)
+    {
+        return false;
+    }
+    _activeRetries++;
+    return true;
+}
+
+void RetryScheduler::release()
+{
+    if (_activeRetries > 0)
+    {
+        _activeRetries--;
+    }
+
+    if (!_slotWaiters.empty())
+    {
+        auto waiter = std::move(_slotWaiters.front());
+        _slotWaiters.pop_front();
+        waiter();
+    }
+}
+
+void RetryScheduler::waitForSlot(std::function<void()> waiter)
+{
+    if (_activeRetries < _maxParallelRetries)
+    {
+        waiter();
+        return;
+    }
+    _slotWaiters.push_back(std::move(waiter));
+}
+
+} // namespace data_sync
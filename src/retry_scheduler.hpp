@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "data_sync_config.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <random>
+
+namespace data_sync
+{
+
+/**
+ * @class RetryScheduler
+ *
+ * @brief This class decides when to retry a failed sync, backing off
+ *        exponentially from the configured retry interval with a random
+ *        jitter, and bounds the number of retries in progress.
+ *
+ * @note The jitter and the bound keep the data which failed together (e.g.
+ *       when the sibling BMC is unreachable) from retrying in lockstep.
+ */
+class RetryScheduler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The maximum number of times the retry interval is doubled.
+     */
+    static constexpr unsigned maxBackoffShift = 6;
+
+    /**
+     * @brief The constructor
+     *
+     * @param[in] maxParallelRetries - The maximum number of retries to be
+     *                                 in progress at a time
+     */
+    explicit RetryScheduler(std::size_t maxParallelRetries);
+
+    /**
+     * @brief Get the time to wait before the next retry.
+     *
+     * @param[in] retry - The retry details of the data
+     * @param[in] retryCount - The number of retries done already
+     * @param[in] engine - The random engine to jitter the delay
+     *
+     * @return The delay, which is picked randomly between the half and the
+     *         full of the backed off interval; nullopt if all the retry
+     *         attempts are done.
+     */
+    static std::optional<Clock::duration>
+        getRetryDelay(const config::Retry& retry, std::uint8_t retryCount,
+                      std::minstd_rand& engine);
+
+    /**
+     * @brief Take a slot to start a retry.
+     *
+     * @return true if a slot is taken; false if the maximum number of
+     *         retries are in progress.
+     */
+    bool tryAcquire();
+
+    /**
+     * @brief Give back the slot of a finished retry, and wake the longest
+     *        waiting one if any.
+     *
+     * @return NULL
+     */
+    void release();
+
+    /**
+     * @brief Wait for a slot to start a retry.
+     *
+     * @param[in] waiter - The callback to invoke once a slot is free, which
+     *                     is invoked right away if a slot is free already
+     *
+     * @return NULL
+     *
+     * @note A single waiter is woken per released slot, in the order they
+     *       wait. The slot is not taken for the waiter, which has to take
+     *       it through tryAcquire() when it starts the retry.
+     */
+    void waitForSlot(std::function<void()> waiter);
+
+    /**
+     * @brief Get the number of retries in progress.
+     *
+     * @return The retries count.
+     */
+    std::size_t getActiveRetries() const
+    {
+        return _activeRetries;
+    }
+
+  private:
+    /**
+     * @brief The maximum number of retries to be in progress at a time.
+     */
+    std::size_t _maxParallelRetries;
+
+    /**
+     * @brief The number of retries in progress.
+     */
+    std::size_t _activeRetries{0};
+
+    /**
+     * @brief The callbacks waiting for a slot, in the order they wait.
+     */
+    std::deque<std::function<void()>> _slotWaiters;
+};
+
+} // namespace data_sync
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sync_journal.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <system_error>
+
+namespace data_sync
+{
+
+namespace
+{
+
+/**
+ * @brief A helper API to frame the begin record of the given sync.
+ *
+ * @param[in] id - The journal id of the sync
+ * @param[in] entry - The details of the sync
+ *
+ * @return The record in JSON format.
+ */
+std::string toBeginRecord(std::uint64_t id, const JournalEntry& entry)
+{
+    nlohmann::json paths = nlohmann::json::array();
+    for (const auto& path : entry._paths)
+    {
+        paths.emplace_back(path.string());
+    }
+    return nlohmann::json{{"Op", "Begin"},
+                          {"Id", id},
+                          {"Path", entry._dataSyncCfgPath},
+                          {"Paths", std::move(paths)}}
+        .dump();
+}
+
+} // namespace
+
+SyncJournal::SyncJournal(const fs::path& journalFile) :
+    _journalFile(journalFile)
+{
+    std::ifstream file(_journalFile);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const auto record = nlohmann::json::parse(line, nullptr, false);
+        if (record.is_discarded() || !record.is_object())
+        {
+            // Torn by the restart while appending.
+            continue;
+        }
+
+        try
+        {
+            const auto id = record.at("Id").get<std::uint64_t>();
+            _nextId = std::max(_nextId, id + 1);
+            if (record.at("Op") == "Begin")
+            {
+                JournalEntry entry{record.at("Path").get<std::string>(), {}};
+                for (const auto& path : record.at("Paths"))
+                {
+                    entry._paths.emplace_back(path.get<std::string>());
+                }
+                _inProgress.insert_or_assign(id, std::move(entry));
+            }
+            else
+            {
+                _inProgress.erase(id);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            lg2::error("Ignoring the invalid sync journal record : {RECORD}, "
+                       "exception : {EXCEPTION}",
+                       "RECORD", line, "EXCEPTION", e);
+        }
+    }
+
+    _interruptedSyncs = _inProgress;
+    compact();
+}
+
+std::uint64_t SyncJournal::begin(const std::string& dataSyncCfgPath,
+                                 const std::vector<fs::path>& paths)
+{
+    const auto id = _nextId++;
+    const auto [entryIt, isAdded] =
+        _inProgress.emplace(id, JournalEntry{dataSyncCfgPath, paths});
+    append(toBeginRecord(id, entryIt->second));
+    return id;
+}
+
+void SyncJournal::end(std::uint64_t id)
+{
+    if (_inProgress.erase(id) == 0)
+    {
+        return;
+    }
+    _interruptedSyncs.erase(id);
+
+    if (_recordsCount >= maxRecords)
+    {
+        compact();
+        return;
+    }
+    append(nlohmann::json{{"Op", "End"}, {"Id", id}}.dump());
+}
+
+void SyncJournal::append(const std::string& record)
+{
+    if (_journalFd() == -1)
+    {
+        return;
+    }
+
+    const auto line = record + '\n';
+    if (write(_journalFd(), line.data(), line.size()) !=
+        static_cast<ssize_t>(line.size()))
+    {
+        lg2::error("Failed to append to the sync journal : {JOURNAL_FILE}, "
+                   "errno : {ERRNO}",
+                   "JOURNAL_FILE", _journalFile, "ERRNO", errno);
+        return;
+    }
+    _recordsCount++;
+}
+
+void SyncJournal::compact()
+{
+    // Replace the journal atomically to not lose the syncs in progress if
+    // the service gets killed in between.
+    std::string records;
+    for (const auto& [id, entry] : _inProgress)
+    {
+        records += toBeginRecord(id, entry);
+        records += '\n';
+    }
+    if (const auto ec = utility::writeFileAtomically(_journalFile, records);
+        ec)
+    {
+        lg2::error("Failed to compact the sync journal : {JOURNAL_FILE}, "
+                   "error : {ERROR}",
+                   "JOURNAL_FILE", _journalFile, "ERROR", ec.message());
+    }
+
+    _journalFd = utility::FD(
+        open(_journalFile.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+             0644));
+    if (_journalFd() == -1)
+    {
+        lg2::error("Failed to open the sync journal : {JOURNAL_FILE}, "
+                   "errno : {ERRNO}",
+                   "JOURNAL_FILE", _journalFile, "ERRNO", errno);
+    }
+    _recordsCount = _inProgress.size();
+}
+
+} // namespace data_sync
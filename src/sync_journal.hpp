@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @brief The details of a sync recorded in the journal.
+ */
+struct JournalEntry
+{
+    /**
+     * @brief The configured path of the data being synced.
+     */
+    std::string _dataSyncCfgPath;
+
+    /**
+     * @brief The changed paths being synced.
+     */
+    std::vector<fs::path> _paths;
+
+    bool operator==(const JournalEntry&) const = default;
+};
+
+/**
+ * @class SyncJournal
+ *
+ * @brief This class keeps an append-only journal of the syncs which are
+ *        started and finished, so that the syncs interrupted by a service
+ *        restart can be resumed on the next start.
+ *
+ * @note Each record is a JSON object in its own line, appended through a
+ *       single write, hence a record torn by the restart is just ignored
+ *       while replaying. The journal is rewritten with only the syncs in
+ *       progress once it grows beyond maxRecords.
+ */
+class SyncJournal
+{
+  public:
+    /**
+     * @brief The number of records after which the journal is compacted.
+     */
+    static constexpr std::size_t maxRecords = 1024;
+
+    /**
+     * @brief The constructor replays the given journal file if exists.
+     *
+     * @param[in] journalFile - The file in which the journal is kept
+     */
+    explicit SyncJournal(const fs::path& journalFile);
+
+    /**
+     * @brief Get the syncs which were not finished when the service
+     *        stopped.
+     *
+     * @return The interrupted syncs keyed by their journal id, which are
+     *         still in progress in the journal till ended.
+     */
+    const std::map<std::uint64_t, JournalEntry>& getInterruptedSyncs() const
+    {
+        return _interruptedSyncs;
+    }
+
+    /**
+     * @brief Record the start of the sync of the given paths.
+     *
+     * @param[in] dataSyncCfgPath - The configured path of the data
+     * @param[in] paths - The changed paths to sync
+     *
+     * @return The journal id of the sync to end it later.
+     */
+    std::uint64_t begin(const std::string& dataSyncCfgPath,
+                        const std::vector<fs::path>& paths);
+
+    /**
+     * @brief Record the end of the given sync, whether it is synced or
+     *        given up.
+     *
+     * @param[in] id - The journal id of the sync
+     *
+     * @return NULL
+     */
+    void end(std::uint64_t id);
+
+    /**
+     * @brief Get the number of syncs in progress.
+     *
+     * @return The count of syncs which are begun but not ended.
+     */
+    std::size_t getInProgressCount() const
+    {
+        return _inProgress.size();
+    }
+
+  private:
+    /**
+     * @brief A helper API to append the given record to the journal file.
+     *
+     * @param[in] record - The record in JSON format
+     *
+     * @return NULL
+     */
+    void append(const std::string& record);
+
+    /**
+     * @brief A helper API to rewrite the journal file with only the syncs
+     *        in progress.
+     *
+     * @return NULL
+     */
+    void compact();
+
+    /**
+     * @brief The file in which the journal is kept.
+     */
+    fs::path _journalFile;
+
+    /**
+     * @brief The journal file opened to append.
+     */
+    utility::FD _journalFd{-1};
+
+    /**
+     * @brief The syncs which are begun but not ended.
+     */
+    std::map<std::uint64_t, JournalEntry> _inProgress;
+
+    /**
+     * @brief The syncs which were in progress when the journal is replayed.
+     */
+    std::map<std::uint64_t, JournalEntry> _interruptedSyncs;
+
+    /**
+     * @brief The journal id to give to the next sync.
+     */
+    std::uint64_t _nextId{1};
+
+    /**
+     * @brief The number of records in the journal file.
+     */
+    std::size_t _recordsCount{0};
+};
+
+} // namespace data_sync
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sync_metrics.hpp"
+
+#include "utility.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace data_sync
+{
+
+SyncMetrics::SyncMetrics(std::size_t entries) :
+    _entryCounters(entries), _isEntryChanged(entries, false)
+{}
+
+void SyncMetrics::resize(std::size_t entries)
+{
+    if (entries > _entryCounters.size())
+    {
+        _entryCounters.resize(entries);
+        _isEntryChanged.resize(entries, false);
+    }
+}
+
+void SyncMetrics::recordSync(std::size_t index,
+                             std::chrono::milliseconds latency, bool isSynced)
+{
+    for (auto* counters : {&_entryCounters[index], &_totalCounters})
+    {
+        if (isSynced)
+        {
+            counters->_syncCount++;
+        }
+        else
+        {
+            counters->_failedSyncCount++;
+        }
+        counters->_lastSyncLatencyInMsec =
+            static_cast<std::uint64_t>(latency.count());
+    }
+    markChanged(index);
+}
+
+void SyncMetrics::recordRetry(std::size_t index)
+{
+    _entryCounters[index]._retryCount++;
+    _totalCounters._retryCount++;
+    markChanged(index);
+}
+
+void SyncMetrics::recordSentBytes(const std::vector<std::size_t>& indices,
+                                  const std::vector<std::uint64_t>& weights,
+                                  std::uint64_t sentBytes)
+{
+    if (sentBytes == 0 || indices.empty())
+    {
+        return;
+    }
+
+    const auto sharedBytes = utility::apportion(sentBytes, weights);
+    for (std::size_t position = 0; position < indices.size(); ++position)
+    {
+        _entryCounters[indices[position]]._sentBytes += sharedBytes[position];
+        markChanged(indices[position]);
+    }
+    _totalCounters._sentBytes += sentBytes;
+    _isTotalChanged = true;
+}
+
+void SyncMetrics::recordStageLatency(
+    SyncStage syncStage, std::chrono::steady_clock::duration latency)
+{
+    _stageLatencies[static_cast<std::size_t>(syncStage)].record(latency);
+    _isTotalChanged = true;
+}
+
+void SyncMetrics::setQueueDepth(std::size_t queueDepth)
+{
+    if (_queueDepth != queueDepth)
+    {
+        _queueDepth = queueDepth;
+        _isTotalChanged = true;
+    }
+}
+
+void SyncMetrics::setCoalescedEventCount(std::uint64_t coalescedEventCount)
+{
+    if (_coalescedEventCount != coalescedEventCount)
+    {
+        _coalescedEventCount = coalescedEventCount;
+        _isTotalChanged = true;
+    }
+}
+
+std::vector<std::size_t> SyncMetrics::takeChangedEntries()
+{
+    for (const auto index : _changedEntries)
+    {
+        _isEntryChanged[index] = false;
+    }
+    std::ranges::sort(_changedEntries);
+    return std::exchange(_changedEntries, {});
+}
+
+bool SyncMetrics::takeTotalChanged()
+{
+    return std::exchange(_isTotalChanged, false);
+}
+
+void SyncMetrics::markChanged(std::size_t index)
+{
+    if (!_isEntryChanged[index])
+    {
+        _isEntryChanged[index] = true;
+        _changedEntries.push_back(index);
+    }
+    _isTotalChanged = true;
+}
+
+} // namespace data_sync
@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "latency_histogram.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace data_sync
+{
+
+/**
+ * @brief The stages of the sync pipeline from a change to its sync.
+ */
+enum class SyncStage : std::uint8_t
+{
+    /**
+     * @brief From the first change event to the end of the quiet window.
+     */
+    Coalesce,
+
+    /**
+     * @brief Reading the state of the changed files to filter out the
+     *        unchanged content and resolve the conflicts.
+     */
+    Filter,
+
+    /**
+     * @brief Waiting in the sync queue for a free transfer.
+     */
+    Queue,
+
+    /**
+     * @brief The transfer, which compresses, sends and applies the data on
+     *        the sibling BMC.
+     */
+    Transfer,
+
+    /**
+     * @brief From the first change event to the end of the sync.
+     */
+    EndToEnd
+};
+
+/**
+ * @brief The number of the sync pipeline stages.
+ */
+constexpr std::size_t syncStagesCount = 5;
+
+/**
+ * @brief Get the name of the given sync pipeline stage.
+ *
+ * @param[in] syncStage - The sync pipeline stage
+ *
+ * @return The stage name.
+ */
+constexpr std::string_view getSyncStageInStr(SyncStage syncStage)
+{
+    switch (syncStage)
+    {
+        case SyncStage::Coalesce:
+            return "Coalesce";
+        case SyncStage::Filter:
+            return "Filter";
+        case SyncStage::Queue:
+            return "Queue";
+        case SyncStage::Transfer:
+            return "Transfer";
+        case SyncStage::EndToEnd:
+            return "EndToEnd";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief The counters of the syncs of a data, or of all data together.
+ */
+struct SyncCounters
+{
+    /**
+     * @brief The number of successful syncs.
+     */
+    std::uint64_t _syncCount{0};
+
+    /**
+     * @brief The number of syncs which failed after all the retries.
+     */
+    std::uint64_t _failedSyncCount{0};
+
+    /**
+     * @brief The number of retries of the failed syncs.
+     */
+    std::uint64_t _retryCount{0};
+
+    /**
+     * @brief The number of bytes sent to the sibling BMC.
+     */
+    std::uint64_t _sentBytes{0};
+
+    /**
+     * @brief The time taken by the last sync in milliseconds, including the
+     *        wait for the bandwidth.
+     */
+    std::uint64_t _lastSyncLatencyInMsec{0};
+
+    bool operator==(const SyncCounters&) const = default;
+};
+
+/**
+ * @class SyncMetrics
+ *
+ * @brief This class keeps the sync counters of each configured data and of
+ *        all data together, and tracks which of them changed so that they
+ *        can be published in batches.
+ *
+ * @note The counters are updated only from the async context, which runs
+ *       in a single thread, and hence they are plain integers. The stage
+ *       latencies are kept for all data together.
+ */
+class SyncMetrics
+{
+  public:
+    /**
+     * @brief The constructor
+     *
+     * @param[in] entries - The number of configured data
+     */
+    explicit SyncMetrics(std::size_t entries);
+
+    /**
+     * @brief Grow the counters for the data added to the configuration.
+     *
+     * @param[in] entries - The number of configured data
+     *
+     * @return NULL
+     *
+     * @note The counters of the existing data are kept.
+     */
+    void resize(std::size_t entries);
+
+    /**
+     * @brief Record the outcome of a sync of the given data.
+     *
+     * @param[in] index - The index of the data in the configuration
+     * @param[in] latency - The time taken by the sync
+     * @param[in] isSynced - Whether the sync is successful
+     *
+     * @return NULL
+     */
+    void recordSync(std::size_t index, std::chrono::milliseconds latency,
+                    bool isSynced);
+
+    /**
+     * @brief Record a retry of the failed sync of the given data.
+     *
+     * @param[in] index - The index of the data in the configuration
+     *
+     * @return NULL
+     */
+    void recordRetry(std::size_t index);
+
+    /**
+     * @brief Record the bytes sent by a transfer of the given data.
+     *
+     * @param[in] indices - The indices of the data synced in the transfer
+     * @param[in] weights - The share of each data in the transfer, e.g.
+     *                      the size of its changed files
+     * @param[in] sentBytes - The bytes sent by the transfer
+     *
+     * @return NULL
+     *
+     * @note The bytes sent per data are not known for a batch, hence the
+     *       transfer is apportioned across the data as per their weights,
+     *       such that the bytes of the data add up to the transfer.
+     */
+    void recordSentBytes(const std::vector<std::size_t>& indices,
+                         const std::vector<std::uint64_t>& weights,
+                         std::uint64_t sentBytes);
+
+    /**
+     * @brief Record the latency of a sync pipeline stage.
+     *
+     * @param[in] syncStage - The sync pipeline stage
+     * @param[in] latency - The time spent in the stage
+     *
+     * @return NULL
+     */
+    void recordStageLatency(SyncStage syncStage,
+                            std::chrono::steady_clock::duration latency);
+
+    /**
+     * @brief Get the latencies of the given sync pipeline stage.
+     *
+     * @param[in] syncStage - The sync pipeline stage
+     *
+     * @return The latency histogram of the stage.
+     */
+    const LatencyHistogram& getStageLatencies(SyncStage syncStage) const
+    {
+        return _stageLatencies[static_cast<std::size_t>(syncStage)];
+    }
+
+    /**
+     * @brief Set the number of syncs waiting in the sync queues.
+     *
+     * @param[in] queueDepth - The number of queued syncs
+     *
+     * @return NULL
+     */
+    void setQueueDepth(std::size_t queueDepth);
+
+    /**
+     * @brief Set the number of change events which didn't need a separate
+     *        sync.
+     *
+     * @param[in] coalescedEventCount - The number of coalesced events
+     *
+     * @return NULL
+     */
+    void setCoalescedEventCount(std::uint64_t coalescedEventCount);
+
+    /**
+     * @brief Get the counters of the given data.
+     *
+     * @param[in] index - The index of the data in the configuration
+     *
+     * @return The counters.
+     */
+    const SyncCounters& getCounters(std::size_t index) const
+    {
+        return _entryCounters[index];
+    }
+
+    /**
+     * @brief Get the counters of all data together.
+     *
+     * @return The counters.
+     */
+    const SyncCounters& getTotalCounters() const
+    {
+        return _totalCounters;
+    }
+
+    /**
+     * @brief Get the number of syncs waiting in the sync queues.
+     */
+    std::uint64_t getQueueDepth() const
+    {
+        return _queueDepth;
+    }
+
+    /**
+     * @brief Get the number of change events which didn't need a separate
+     *        sync.
+     */
+    std::uint64_t getCoalescedEventCount() const
+    {
+        return _coalescedEventCount;
+    }
+
+    /**
+     * @brief Take the data whose counters changed since the last take.
+     *
+     * @return The indices of the changed data in ascending order.
+     */
+    std::vector<std::size_t> takeChangedEntries();
+
+    /**
+     * @brief Take whether the total counters or the gauges changed since
+     *        the last take.
+     *
+     * @return true if changed.
+     */
+    bool takeTotalChanged();
+
+  private:
+    /**
+     * @brief A helper API to mark the given data as changed.
+     */
+    void markChanged(std::size_t index);
+
+    /**
+     * @brief The counters of each data by its index in the configuration.
+     */
+    std::vector<SyncCounters> _entryCounters;
+
+    /**
+     * @brief The counters of all data together.
+     */
+    SyncCounters _totalCounters;
+
+    /**
+     * @brief The latencies of each sync pipeline stage.
+     */
+    std::array<LatencyHistogram, syncStagesCount> _stageLatencies;
+
+    /**
+     * @brief The number of syncs waiting in the sync queues.
+     */
+    std::uint64_t _queueDepth{0};
+
+    /**
+     * @brief The number of change events which didn't need a separate sync.
+     */
+    std::uint64_t _coalescedEventCount{0};
+
+    /**
+     * @brief Whether the counters of the data changed since the last take.
+     */
+    std::vector<bool> _isEntryChanged;
+
+    /**
+     * @brief The data whose counters changed since the last take.
+     */
+    std::vector<std::size_t> _changedEntries;
+
+    /**
+     * @brief Whether the total counters or the gauges changed since the
+     *        last take.
+     */
+    bool _isTotalChanged{false};
+};
+
+} // namespace data_sync
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace data_sync
+{
+
+namespace
+{
+
+/**
+ * @brief The mask to get the slot index of a level from the tick.
+ */
+constexpr TimerWheel::Tick slotMask = 63;
+
+} // namespace
+
+void TimerWheel::schedule(TimerId timerId, Tick ticksFromNow)
+{
+    std::vector<TimerId> expiredTimers;
+    _timersCount++;
+    place(Timer{timerId, _currentTick + std::max<Tick>(ticksFromNow, 1)},
+          expiredTimers);
+}
+
+bool TimerWheel::cancel(TimerId timerId)
+{
+    std::size_t cancelledTimers = 0;
+    for (auto& level : _levels)
+    {
+        for (auto& slot : level)
+        {
+            cancelledTimers += std::erase_if(
+                slot, [timerId](const auto& timer) {
+                return timer._timerId == timerId;
+            });
+        }
+    }
+    _timersCount -= cancelledTimers;
+    return cancelledTimers > 0;
+}
+
+void TimerWheel::place(const Timer& timer, std::vector<TimerId>& expiredTimers)
+{
+    if (timer._expiryTick <= _currentTick)
+    {
+        expiredTimers.push_back(timer._timerId);
+        _timersCount--;
+        return;
+    }
+
+    const auto ticksToExpire = timer._expiryTick - _currentTick;
+    for (std::size_t level = 0; level < levelsCount; ++level)
+    {
+        const auto levelSpan = Tick{1} << (slotBits * (level + 1));
+        if (ticksToExpire < levelSpan || level == levelsCount - 1)
+        {
+            // Park the timers beyond the range of the wheel in the farthest
+            // slot, they will be placed again once cascaded.
+            const auto placementTick =
+                ticksToExpire < levelSpan ? timer._expiryTick
+                                          : _currentTick + levelSpan - 1;
+            const auto slot = (placementTick >> (slotBits * level)) & slotMask;
+            _levels[level][slot].push_back(timer);
+            return;
+        }
+    }
+}
+
+void TimerWheel::tick(std::vector<TimerId>& expiredTimers)
+{
+    _currentTick++;
+
+    // Cascade the timers of the higher levels if the wheel reached
+    // the boundary of their slots.
+    for (auto level = levelsCount - 1; level > 0; --level)
+    {
+        const auto shift = slotBits * level;
+        if ((_currentTick & ((Tick{1} << shift) - 1)) != 0)
+        {
+            continue;
+        }
+
+        auto timers =
+            std::exchange(_levels[level][(_currentTick >> shift) & slotMask],
+                          Slot{});
+        std::ranges::for_each(timers,
+                              [this, &expiredTimers](const auto& timer) {
+            place(timer, expiredTimers);
+        });
+    }
+
+    auto& slot = _levels[0][_currentTick & slotMask];
+    std::ranges::transform(slot, std::back_inserter(expiredTimers),
+                           [](const auto& timer) { return timer._timerId; });
+    _timersCount -= slot.size();
+    slot.clear();
+}
+
+std::vector<TimerWheel::TimerId> TimerWheel::advanceTo(Tick tick)
+{
+    std::vector<TimerId> expiredTimers;
+
+    while (_currentTick < tick)
+    {
+        // Nothing happens in between the wakeup ticks, hence skip them.
+        const auto nextWakeupTick = getNextWakeupTick();
+        if (!nextWakeupTick.has_value() || *nextWakeupTick > tick)
+        {
+            _currentTick = tick;
+            break;
+        }
+        _currentTick = *nextWakeupTick - 1;
+        this->tick(expiredTimers);
+    }
+
+    return expiredTimers;
+}
+
+std::optional<TimerWheel::Tick> TimerWheel::getNextWakeupTick() const
+{
+    if (_timersCount == 0)
+    {
+        return std::nullopt;
+    }
+
+    std::optional<Tick> nextWakeupTick;
+    for (std::size_t level = 0; level < levelsCount; ++level)
+    {
+        const auto shift = slotBits * level;
+        const auto levelTick = _currentTick >> shift;
+        for (Tick offset = 1; offset <= slotsCount; ++offset)
+        {
+            if (!_levels[level][(levelTick + offset) & slotMask].empty())
+            {
+                const auto wakeupTick = (levelTick + offset) << shift;
+                nextWakeupTick = std::min(nextWakeupTick.value_or(wakeupTick),
+                                          wakeupTick);
+                break;
+            }
+        }
+    }
+
+    return nextWakeupTick;
+}
+
+} // namespace data_sync
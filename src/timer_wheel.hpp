@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace data_sync
+{
+
+/**
+ * @class TimerWheel
+ *
+ * @brief A hierarchical timer wheel to schedule lots of timers with O(1)
+ *        insertion and a single wakeup for all timers expiring at the
+ *        same tick.
+ *
+ * @note The wheel doesn't track the wall clock, the owner has to advance
+ *       it to the current tick. Each level has 64 slots, and every slot
+ *       of a level covers 64 slots of the previous level. The timers of a
+ *       slot in the higher levels are cascaded into the lower levels when
+ *       the wheel reaches that slot.
+ */
+class TimerWheel
+{
+  public:
+    using Tick = std::uint64_t;
+    using TimerId = std::size_t;
+
+    /**
+     * @brief Schedule a timer to expire after the given ticks.
+     *
+     * @param[in] timerId - The identifier to return on expiry
+     * @param[in] ticksFromNow - The number of ticks after which the timer
+     *                           expires. Zero is considered as one tick.
+     */
+    void schedule(TimerId timerId, Tick ticksFromNow);
+
+    /**
+     * @brief Cancel the timers of the given identifier.
+     *
+     * @param[in] timerId - The identifier of the timers to cancel
+     *
+     * @return true if any timer is cancelled.
+     *
+     * @note All the slots are scanned, which is fine as the timers are
+     *       cancelled only on a configuration change.
+     */
+    bool cancel(TimerId timerId);
+
+    /**
+     * @brief Advance the wheel till the given tick.
+     *
+     * @param[in] tick - The current tick
+     *
+     * @return The timers expired on or before the given tick.
+     */
+    std::vector<TimerId> advanceTo(Tick tick);
+
+    /**
+     * @brief Get the tick at which the wheel has to be advanced next.
+     *
+     * @return The tick at which either a timer expires or the timers need
+     *         to be cascaded; nullopt if no timer is scheduled.
+     */
+    std::optional<Tick> getNextWakeupTick() const;
+
+    /**
+     * @brief Get the tick till which the wheel is advanced.
+     *
+     * @return The current tick.
+     */
+    Tick getCurrentTick() const
+    {
+        return _currentTick;
+    }
+
+    /**
+     * @brief Get the number of scheduled timers.
+     *
+     * @return The timers count.
+     */
+    std::size_t size() const
+    {
+        return _timersCount;
+    }
+
+  private:
+    /**
+     * @brief The number of bits of the tick which index the slots of
+     *        a level.
+     */
+    static constexpr unsigned slotBits = 6;
+
+    /**
+     * @brief The number of slots in a level.
+     */
+    static constexpr std::size_t slotsCount = 1U << slotBits;
+
+    /**
+     * @brief The number of levels, which covers 64^4 ticks. Timers beyond
+     *        that are parked in the last level till they come in range.
+     */
+    static constexpr std::size_t levelsCount = 4;
+
+    /**
+     * @brief A scheduled timer.
+     */
+    struct Timer
+    {
+        TimerId _timerId;
+        Tick _expiryTick;
+    };
+
+    using Slot = std::vector<Timer>;
+    using Level = std::array<Slot, slotsCount>;
+
+    /**
+     * @brief A helper API to place the given timer into the wheel based on
+     *        its distance from the current tick.
+     *
+     * @param[in] timer - The timer to place
+     * @param[out] expiredTimers - The list to add the timer into if it is
+     *                             already expired
+     */
+    void place(const Timer& timer, std::vector<TimerId>& expiredTimers);
+
+    /**
+     * @brief A helper API to advance the wheel by one tick.
+     *
+     * @param[out] expiredTimers - The list to add the expired timers into
+     */
+    void tick(std::vector<TimerId>& expiredTimers);
+
+    /**
+     * @brief The levels of the wheel.
+     */
+    std::array<Level, levelsCount> _levels;
+
+    /**
+     * @brief The tick till which the wheel is advanced.
+     */
+    Tick _currentTick{0};
+
+    /**
+     * @brief The number of scheduled timers.
+     */
+    std::size_t _timersCount{0};
+};
+
+} // namespace data_sync
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "token_bucket.hpp"
+
+#include <algorithm>
+
+namespace data_sync
+{
+
+TokenBucket::TokenBucket(std::uint64_t ratePerSec, std::uint64_t burst,
+                         Clock::time_point now) :
+    _ratePerSec(ratePerSec), _burst(static_cast<double>(burst)),
+    _tokens(static_cast<double>(burst)), _lastRefillTime(now)
+{}
+
+TokenBucket::Clock::duration
+    TokenBucket::timeToAvailable(Clock::time_point now)
+{
+    if (isUnlimited())
+    {
+        return Clock::duration::zero();
+    }
+
+    refill(now);
+    if (_tokens >= 0)
+    {
+        return Clock::duration::zero();
+    }
+
+    return std::chrono::ceil<Clock::duration>(std::chrono::duration<double>(
+        -_tokens / static_cast<double>(_ratePerSec)));
+}
+
+void TokenBucket::consume(std::uint64_t tokens, Clock::time_point startTime,
+                          Clock::time_point now)
+{
+    if (isUnlimited())
+    {
+        return;
+    }
+
+    // The bucket is idle only till the traffic started, the tokens refilled
+    // since then are spent by the traffic and are capped only once taken.
+    refill(std::min(startTime, now));
+    if (now > _lastRefillTime)
+    {
+        const std::chrono::duration<double> elapsed = now - _lastRefillTime;
+        _tokens += elapsed.count() * static_cast<double>(_ratePerSec);
+        _lastRefillTime = now;
+    }
+    _tokens = std::min(_burst, _tokens - static_cast<double>(tokens));
+}
+
+void TokenBucket::refill(Clock::time_point now)
+{
+    if (now <= _lastRefillTime)
+    {
+        return;
+    }
+
+    const std::chrono::duration<double> elapsed = now - _lastRefillTime;
+    _tokens = std::min(
+        _burst, _tokens + (elapsed.count() * static_cast<double>(_ratePerSec)));
+    _lastRefillTime = now;
+}
+
+} // namespace data_sync
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace data_sync
+{
+
+/**
+ * @class TokenBucket
+ *
+ * @brief This class limits the average rate of a traffic, where the tokens
+ *        are refilled at the given rate up to the burst size and the
+ *        traffic takes one token per byte.
+ *
+ * @note The amount of traffic is known only once it is done (e.g. the bytes
+ *       sent by a transfer), hence the tokens are consumed after the fact
+ *       and may go negative. The next traffic has to wait till the debt is
+ *       paid back by the refill. The burst caps only the tokens accumulated
+ *       while idle, the tokens refilled while the traffic runs are used by
+ *       the traffic itself.
+ */
+class TokenBucket
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief The constructor
+     *
+     * @param[in] ratePerSec - The tokens to refill per second, where zero
+     *                         indicates no limit
+     * @param[in] burst - The maximum tokens to accumulate while idle
+     * @param[in] now - The current time
+     */
+    TokenBucket(std::uint64_t ratePerSec, std::uint64_t burst,
+                Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Check whether the bucket limits the rate.
+     *
+     * @return true if the rate is not limited.
+     */
+    bool isUnlimited() const
+    {
+        return _ratePerSec == 0;
+    }
+
+    /**
+     * @brief Get the time to wait before the next traffic is allowed.
+     *
+     * @param[in] now - The current time
+     *
+     * @return The time till the tokens are not negative; zero if the
+     *         traffic is allowed right away.
+     */
+    Clock::duration timeToAvailable(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Take the given tokens for the traffic which is done.
+     *
+     * @param[in] tokens - The amount of the traffic
+     * @param[in] startTime - The time at which the traffic started
+     * @param[in] now - The current time
+     *
+     * @return NULL
+     */
+    void consume(std::uint64_t tokens, Clock::time_point startTime,
+                 Clock::time_point now = Clock::now());
+
+  private:
+    /**
+     * @brief A helper API to add the tokens for the time elapsed since the
+     *        last refill.
+     *
+     * @param[in] now - The current time
+     *
+     * @return NULL
+     */
+    void refill(Clock::time_point now);
+
+    /**
+     * @brief The tokens to refill per second.
+     */
+    std::uint64_t _ratePerSec;
+
+    /**
+     * @brief The maximum tokens to accumulate.
+     */
+    double _burst;
+
+    /**
+     * @brief The available tokens, negative if the consumed traffic is
+     *        more than the available tokens.
+     */
+    double _tokens;
+
+    /**
+     * @brief The time at which the tokens are refilled last.
+     */
+    Clock::time_point _lastRefillTime;
+};
+
+} // namespace data_sync
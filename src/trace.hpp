@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "config.h"
+
+/**
+ * @brief The trace points of the sync pipeline.
+ *
+ * DATA_SYNC_TRACE(name, args...) adds a USDT probe named 'name' of the
+ * 'data_sync' provider which passes the given (at least one) arguments,
+ * e.g. to trace with `bpftrace -e 'usdt:<binary>:data_sync:<name> {...}'`.
+ *
+ * The probes are compiled in only if the 'tracing' option is enabled, and
+ * an unused probe costs a single nop instruction.
+ */
+#if DATA_SYNC_TRACING
+#include <sys/sdt.h>
+#define DATA_SYNC_TRACE(name, ...) STAP_PROBEV(data_sync, name, __VA_ARGS__)
+#else
+#define DATA_SYNC_TRACE(name, ...)
+#endif
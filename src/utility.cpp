@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "utility.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <numeric>
+#include <string>
+
+namespace data_sync::utility
+{
+
+namespace fs = std::filesystem;
+
+std::error_code writeFileAtomically(const fs::path& file, std::string_view data)
+{
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+    if (ec)
+    {
+        return ec;
+    }
+
+    std::string tmpFile =
+        (file.parent_path() / ("." + file.filename().string() + ".XXXXXX"))
+            .string();
+    FD tmpFd(mkostemp(tmpFile.data(), O_CLOEXEC));
+    if (tmpFd() == -1)
+    {
+        return {errno, std::generic_category()};
+    }
+
+    int err = 0;
+    while (!data.empty())
+    {
+        const auto written = write(tmpFd(), data.data(), data.size());
+        if (written == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            err = errno;
+            break;
+        }
+        data.remove_prefix(static_cast<std::size_t>(written));
+    }
+
+    // The content has to be on the disk before the rename, else the file
+    // may be found empty after a crash.
+    if (err == 0 && (fchmod(tmpFd(), 0644) == -1 || fsync(tmpFd()) == -1))
+    {
+        err = errno;
+    }
+    tmpFd.reset();
+    if (err == 0 && rename(tmpFile.c_str(), file.c_str()) == -1)
+    {
+        err = errno;
+    }
+    if (err != 0)
+    {
+        unlink(tmpFile.c_str());
+        return {err, std::generic_category()};
+    }
+
+    FD dirFd(open(file.parent_path().c_str(),
+                  O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dirFd() == -1 || fsync(dirFd()) == -1)
+    {
+        return {errno, std::generic_category()};
+    }
+    return {};
+}
+
+RsyncDest parseRsyncDest(std::string_view dest)
+{
+    // rsync considers the destination as remote if a colon comes before
+    // any slash, and reaches it through a daemon rather than a shell if
+    // the colon is doubled or given as an rsync:// URL. The colons of an
+    // IPv6 address are enclosed in brackets.
+    if (dest.starts_with("rsync://"))
+    {
+        return {RsyncDest::Kind::Daemon, {}};
+    }
+
+    std::size_t hostEnd = 0;
+    if (const auto bracketPos = dest.find('[');
+        bracketPos < dest.find_first_of(":/"))
+    {
+        hostEnd = dest.find(']', bracketPos);
+    }
+    const auto colonPos = dest.find(':', hostEnd);
+    if (colonPos == 0 || colonPos == std::string_view::npos ||
+        dest.find('/') < colonPos)
+    {
+        return {RsyncDest::Kind::Local, {}};
+    }
+    if (dest.substr(colonPos).starts_with("::"))
+    {
+        return {RsyncDest::Kind::Daemon, {}};
+    }
+
+    // The brackets are only to tell the host apart from the path, and are
+    // not taken by SSH.
+    std::string remoteHost(dest.substr(0, colonPos));
+    std::erase_if(remoteHost, [](char c) { return c == '[' || c == ']'; });
+    return {RsyncDest::Kind::Shell, std::move(remoteHost)};
+}
+
+std::vector<std::uint64_t> apportion(std::uint64_t total,
+                                     const std::vector<std::uint64_t>& weights)
+{
+    const auto totalWeight =
+        std::accumulate(weights.begin(), weights.end(), std::uint64_t{0});
+    std::vector<std::uint64_t> shares;
+    shares.reserve(weights.size());
+    std::uint64_t apportioned = 0;
+    for (std::size_t position = 0; position < weights.size(); ++position)
+    {
+        auto share = total - apportioned;
+        if (position + 1 < weights.size())
+        {
+            const auto fraction =
+                totalWeight == 0
+                    ? 1.0 / static_cast<double>(weights.size())
+                    : static_cast<double>(weights[position]) /
+                          static_cast<double>(totalWeight);
+            share = std::min(share, static_cast<std::uint64_t>(
+                                        static_cast<double>(total) * fraction));
+        }
+        apportioned += share;
+        shares.push_back(share);
+    }
+    return shares;
+}
+
+} // namespace data_sync::utility
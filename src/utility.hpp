@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace data_sync::utility
+{
+
+/**
+ * @class FD
+ *
+ * @brief A RAII wrapper for a file descriptor which closes the file
+ *        descriptor when the instance goes out of scope.
+ */
+class FD
+{
+  public:
+    FD() = delete;
+    FD(const FD&) = delete;
+    FD& operator=(const FD&) = delete;
+
+    /**
+     * @brief The constructor
+     *
+     * @param[in] fd - The file descriptor to own
+     */
+    explicit FD(int fd) : _fd(fd) {}
+
+    FD(FD&& other) noexcept : _fd(std::exchange(other._fd, -1)) {}
+
+    FD& operator=(FD&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _fd = std::exchange(other._fd, -1);
+        }
+        return *this;
+    }
+
+    ~FD()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Get the owned file descriptor.
+     *
+     * @return The file descriptor; -1 if it is not valid.
+     */
+    int operator()() const
+    {
+        return _fd;
+    }
+
+    /**
+     * @brief Give up the ownership of the file descriptor.
+     *
+     * @return The file descriptor which the caller has to close.
+     */
+    int release()
+    {
+        return std::exchange(_fd, -1);
+    }
+
+    /**
+     * @brief Close the owned file descriptor if it is valid.
+     */
+    void reset()
+    {
+        if (_fd >= 0)
+        {
+            close(_fd);
+            _fd = -1;
+        }
+    }
+
+  private:
+    /**
+     * @brief The owned file descriptor.
+     */
+    int _fd;
+};
+
+/**
+ * @brief Write the given data into the given file atomically, such that the
+ *        file holds either its old or the new content even if the service
+ *        gets killed or the BMC crashes in between.
+ *
+ * @param[in] file - The file to write, whose parent directories are created
+ *                   if missing
+ * @param[in] data - The content of the file
+ *
+ * @return An empty error code on success; otherwise, the failure reason.
+ *
+ * @note The data is written into a temporary file next to the given file,
+ *       which is flushed before renaming it over the file. The directory
+ *       is flushed after the rename to make it durable.
+ */
+std::error_code writeFileAtomically(const std::filesystem::path& file,
+                                    std::string_view data);
+
+/**
+ * @brief The structure contains the parts of a destination given in the
+ *        rsync format.
+ */
+struct RsyncDest
+{
+    /**
+     * @brief The enum contains the ways rsync reaches a destination.
+     */
+    enum class Kind
+    {
+        Local,
+        Shell,
+        Daemon
+    };
+
+    /**
+     * @brief The way rsync reaches the destination.
+     */
+    Kind _kind;
+
+    /**
+     * @brief The [user@]host of the destination reached over a remote
+     *        shell, without the brackets around an IPv6 address.
+     *
+     * @note Empty for the other destinations.
+     */
+    std::string _remoteHost;
+};
+
+/**
+ * @brief Parse the given destination in the rsync format the way rsync
+ *        does.
+ *
+ * @param[in] dest - The destination, e.g. "/tmp/peer/", "bmc1:/",
+ *                   "root@[fe80::1]:/", "bmc1::module/" or
+ *                   "rsync://bmc1/module/"
+ *
+ * @return The parts of the destination.
+ */
+RsyncDest parseRsyncDest(std::string_view dest);
+
+/**
+ * @brief Split the given total into the shares of the given weights.
+ *
+ * @param[in] total - The total to split, e.g. the bytes sent by a transfer
+ * @param[in] weights - The weight of each share
+ *
+ * @return The shares in the order of the weights, which add up to the
+ *         total.
+ *
+ * @note The shares are equal if no share has any weight, and the last share
+ *       takes what is left by the rounding.
+ */
+std::vector<std::uint64_t> apportion(std::uint64_t total,
+                                     const std::vector<std::uint64_t>& weights);
+
+} // namespace data_sync::utility
@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "version_vector.hpp"
+
+#include "utility.hpp"
+
+#include <sys/xattr.h>
+
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/lg2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <numeric>
+#include <tuple>
+
+namespace data_sync
+{
+
+void VersionVector::increment(const std::string& bmcId)
+{
+    _counters[bmcId]++;
+}
+
+void VersionVector::merge(const VersionVector& other)
+{
+    for (const auto& [bmcId, count] : other._counters)
+    {
+        auto& ownCount = _counters[bmcId];
+        ownCount = std::max(ownCount, count);
+    }
+}
+
+VersionVector::Order VersionVector::compare(const VersionVector& other) const
+{
+    const auto getCount = [](const auto& counters, const std::string& bmcId) {
+        const auto it = counters.find(bmcId);
+        return it == counters.end() ? std::uint64_t{0} : it->second;
+    };
+
+    bool hasLess = false;
+    bool hasGreater = false;
+    for (const auto& [bmcId, count] : _counters)
+    {
+        const auto otherCount = getCount(other._counters, bmcId);
+        hasLess |= count < otherCount;
+        hasGreater |= count > otherCount;
+    }
+    for (const auto& [bmcId, otherCount] : other._counters)
+    {
+        hasLess |= getCount(_counters, bmcId) < otherCount;
+    }
+
+    if (hasLess && hasGreater)
+    {
+        return Order::Concurrent;
+    }
+    if (hasLess)
+    {
+        return Order::Before;
+    }
+    return hasGreater ? Order::After : Order::Equal;
+}
+
+bool VersionVector::isPreferredOver(const VersionVector& other) const
+{
+    const auto getTotal = [](const auto& counters) {
+        return std::accumulate(
+            counters.begin(), counters.end(), std::uint64_t{0},
+            [](auto sum, const auto& counter) { return sum + counter.second; });
+    };
+    return std::make_tuple(getTotal(_counters), toString()) >
+           std::make_tuple(getTotal(other._counters), other.toString());
+}
+
+std::string VersionVector::toString() const
+{
+    std::string version;
+    for (const auto& [bmcId, count] : _counters)
+    {
+        if (!version.empty())
+        {
+            version.push_back(',');
+        }
+        version.append(bmcId).push_back(':');
+        version.append(std::to_string(count));
+    }
+    return version;
+}
+
+std::optional<VersionVector> VersionVector::fromString(std::string_view version)
+{
+    VersionVector versionVector;
+    while (!version.empty())
+    {
+        const auto counterEnd = version.find(',');
+        const auto counter = version.substr(0, counterEnd);
+        const auto separator = counter.rfind(':');
+        if (separator == std::string_view::npos || separator == 0)
+        {
+            return std::nullopt;
+        }
+
+        std::uint64_t count{0};
+        const auto countStr = counter.substr(separator + 1);
+        const auto [ptr, ec] = std::from_chars(
+            countStr.data(), countStr.data() + countStr.size(), count);
+        if (ec != std::errc{} || ptr != countStr.data() + countStr.size())
+        {
+            return std::nullopt;
+        }
+        versionVector._counters.emplace(counter.substr(0, separator), count);
+
+        version = counterEnd == std::string_view::npos
+                      ? std::string_view{}
+                      : version.substr(counterEnd + 1);
+    }
+    return versionVector;
+}
+
+std::optional<VersionVector> VersionVector::read(const fs::path& path)
+{
+    std::array<char, 1024> version{};
+    const auto size =
+        lgetxattr(path.c_str(), xattrName, version.data(), version.size());
+    if (size <= 0)
+    {
+        return std::nullopt;
+    }
+    return fromString(
+        std::string_view(version.data(), static_cast<std::size_t>(size)));
+}
+
+bool VersionVector::write(const fs::path& path) const
+{
+    const auto version = toString();
+    return lsetxattr(path.c_str(), xattrName, version.data(), version.size(),
+                     0) == 0;
+}
+
+VersionStore::VersionStore(const fs::path& persistFile) :
+    _persistFile(persistFile)
+{
+    std::error_code ec;
+    if (!fs::exists(_persistFile, ec))
+    {
+        return;
+    }
+
+    try
+    {
+        std::ifstream file(_persistFile);
+        const auto storeJSON = nlohmann::json::parse(file);
+        for (const auto& [path, version] : storeJSON.items())
+        {
+            if (auto versionVector =
+                    VersionVector::fromString(version.get<std::string>());
+                versionVector.has_value())
+            {
+                _versions.emplace(path, std::move(versionVector.value()));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        // Start with an empty store, the next changes of the files will be
+        // considered as the local changes.
+        lg2::error("Failed to load the version store : {STORE_FILE}, "
+                   "exception : {EXCEPTION}",
+                   "STORE_FILE", _persistFile, "EXCEPTION", e);
+        _versions.clear();
+    }
+}
+
+VersionVector VersionStore::get(const fs::path& path) const
+{
+    const auto it = _versions.find(path.string());
+    return it == _versions.end() ? VersionVector{} : it->second;
+}
+
+void VersionStore::set(const fs::path& path, const VersionVector& version)
+{
+    auto& storedVersion = _versions[path.string()];
+    if (storedVersion != version)
+    {
+        storedVersion = version;
+        _isDirty = true;
+    }
+}
+
+void VersionStore::persist()
+{
+    if (!_isDirty)
+    {
+        return;
+    }
+
+    nlohmann::json storeJSON = nlohmann::json::object();
+    for (const auto& [path, version] : _versions)
+    {
+        storeJSON[path] = version.toString();
+    }
+
+    // Replace the store atomically to not leave a partially written store
+    // if the service gets killed in between.
+    if (const auto ec =
+            utility::writeFileAtomically(_persistFile, storeJSON.dump());
+        ec)
+    {
+        lg2::error("Failed to persist the version store : {STORE_FILE}, "
+                   "error : {ERROR}",
+                   "STORE_FILE", _persistFile, "ERROR", ec.message());
+        return;
+    }
+    _isDirty = false;
+}
+
+} // namespace data_sync
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace data_sync
+{
+
+namespace fs = std::filesystem;
+
+/**
+ * @class VersionVector
+ *
+ * @brief This class tracks the version of a file as the number of changes
+ *        made on each BMC, so that the concurrent changes made on both BMCs
+ *        can be told apart from the changes which are based on the other.
+ */
+class VersionVector
+{
+  public:
+    /**
+     * @brief The order of two versions.
+     */
+    enum class Order
+    {
+        Equal,
+        Before,
+        After,
+        Concurrent
+    };
+
+    /**
+     * @brief The extended attribute in which the version of a file is
+     *        kept, which is transferred along with the file.
+     */
+    static constexpr auto xattrName = "user.data-sync.version";
+
+    /**
+     * @brief Record a change made on the given BMC.
+     *
+     * @param[in] bmcId - The id of the BMC
+     *
+     * @return NULL
+     */
+    void increment(const std::string& bmcId);
+
+    /**
+     * @brief Merge the given version into this version, which then includes
+     *        the changes of both.
+     *
+     * @param[in] other - The version to merge
+     *
+     * @return NULL
+     */
+    void merge(const VersionVector& other);
+
+    /**
+     * @brief Compare this version with the given version.
+     *
+     * @param[in] other - The version to compare with
+     *
+     * @return Before if this version is included in the other version,
+     *         After if this version includes the other version, Equal if
+     *         both are the same; otherwise, Concurrent.
+     */
+    Order compare(const VersionVector& other) const;
+
+    /**
+     * @brief Check whether this version wins over the given concurrent
+     *        version.
+     *
+     * @param[in] other - The concurrent version
+     *
+     * @return true if this version wins.
+     *
+     * @note The version with more changes wins and the ties are broken by
+     *       the serialized versions, so that both BMCs pick the same winner
+     *       without consulting each other.
+     */
+    bool isPreferredOver(const VersionVector& other) const;
+
+    /**
+     * @brief Serialize the version as "<bmcId>:<count>" separated by ",".
+     *
+     * @return The serialized version
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Parse the serialized version.
+     *
+     * @param[in] version - The version in the toString() format
+     *
+     * @return The version on success; nullopt if the format is invalid.
+     */
+    static std::optional<VersionVector> fromString(std::string_view version);
+
+    /**
+     * @brief Read the version of the given file from its extended
+     *        attribute.
+     *
+     * @param[in] path - The file path
+     *
+     * @return The version; nullopt if the file has no valid version.
+     */
+    static std::optional<VersionVector> read(const fs::path& path);
+
+    /**
+     * @brief Write this version into the extended attribute of the given
+     *        file.
+     *
+     * @param[in] path - The file path
+     *
+     * @return true on success.
+     */
+    bool write(const fs::path& path) const;
+
+    bool operator==(const VersionVector&) const = default;
+
+  private:
+    /**
+     * @brief The number of changes made on each BMC, keyed on the BMC id.
+     */
+    std::map<std::string, std::uint64_t, std::less<>> _counters;
+};
+
+/**
+ * @class VersionStore
+ *
+ * @brief This class remembers the version of the files as last known on
+ *        this BMC, to detect whether a file got changed locally or by a
+ *        transfer from the sibling BMC.
+ *
+ * @note The store is persisted, so that the versions survive a restart.
+ */
+class VersionStore
+{
+  public:
+    /**
+     * @brief The constructor loads the store from the given file if exists.
+     *
+     * @param[in] persistFile - The file in which the store is persisted
+     */
+    explicit VersionStore(const fs::path& persistFile);
+
+    /**
+     * @brief Get the last known version of the given file.
+     *
+     * @param[in] path - The file path
+     *
+     * @return The version; an empty version if not known.
+     */
+    VersionVector get(const fs::path& path) const;
+
+    /**
+     * @brief Record the given version as the last known version.
+     *
+     * @param[in] path - The file path
+     * @param[in] version - The version of the file
+     *
+     * @return NULL
+     */
+    void set(const fs::path& path, const VersionVector& version);
+
+    /**
+     * @brief Write the store into the persist file if it is modified.
+     *
+     * @return NULL
+     */
+    void persist();
+
+    /**
+     * @brief Check whether the store has the changes to persist.
+     *
+     * @return true if the store is modified after the last persist.
+     */
+    bool isDirty() const
+    {
+        return _isDirty;
+    }
+
+  private:
+    /**
+     * @brief The file in which the store is persisted.
+     */
+    fs::path _persistFile;
+
+    /**
+     * @brief The last known version of the files.
+     */
+    std::unordered_map<std::string, VersionVector> _versions;
+
+    /**
+     * @brief Whether the store is modified after the last persist.
+     */
+    bool _isDirty{false};
+};
+
+} // namespace data_sync
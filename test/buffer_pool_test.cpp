@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "buffer_pool.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+/*
+ * Test that the buffers are leased till the pool is exhausted and are
+ * reused once returned.
+ */
+TEST(BufferPoolTest, TestLeaseAndReturn)
+{
+    data_sync::BufferPool pool(1024, 2);
+    EXPECT_EQ(pool.getFreeBuffersCount(), 2U);
+
+    auto first = pool.acquire();
+    auto second = pool.acquire();
+    EXPECT_EQ(first.get().size(), 1024U);
+    EXPECT_EQ(second.get().size(), 1024U);
+    EXPECT_NE(first.get().data(), second.get().data());
+    EXPECT_EQ(pool.getFreeBuffersCount(), 0U);
+
+    // The pool doesn't grow beyond its buffers.
+    EXPECT_TRUE(pool.acquire().get().empty());
+
+    auto* firstBuffer = first.get().data();
+    {
+        auto moved = std::move(first);
+        EXPECT_TRUE(first.get().empty());
+        EXPECT_EQ(pool.getFreeBuffersCount(), 0U);
+    }
+    EXPECT_EQ(pool.getFreeBuffersCount(), 1U);
+    EXPECT_EQ(pool.acquire().get().data(), firstBuffer);
+}
+
+/*
+ * Test that the buffer size is rounded up to keep the buffers aligned.
+ */
+TEST(BufferPoolTest, TestBufferAlignment)
+{
+    data_sync::BufferPool pool(10, 3);
+    EXPECT_EQ(pool.getBufferSize() % alignof(std::max_align_t), 0U);
+    EXPECT_GE(pool.getBufferSize(), 10U);
+
+    for (std::size_t index = 0; index < 3; ++index)
+    {
+        auto lease = pool.acquire();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(lease.get().data()) %
+                      alignof(std::max_align_t),
+                  0U);
+    }
+}
+
+/*
+ * Test that the arena allocates from the pooled buffer, falls back to the
+ * heap once the pool is exhausted, and returns the buffer at the end.
+ */
+TEST(BufferPoolTest, TestSyncArena)
+{
+    data_sync::BufferPool pool(4096, 1);
+    const auto* pooledBuffer = pool.acquire().get().data();
+    const auto isPooled = [pooledBuffer](const void* data) {
+        const auto* byte = static_cast<const std::byte*>(data);
+        return byte >= pooledBuffer && byte < pooledBuffer + 4096;
+    };
+
+    {
+        data_sync::SyncArena arena(pool);
+        EXPECT_EQ(pool.getFreeBuffersCount(), 0U);
+
+        std::pmr::string pathsToSync(1024, 'x', arena.get());
+        EXPECT_TRUE(isPooled(pathsToSync.data()));
+
+        // Beyond the pooled buffer, the memory comes from the heap.
+        std::pmr::string morePaths(8192, 'x', arena.get());
+        EXPECT_FALSE(isPooled(morePaths.data()));
+
+        // The pool is exhausted, hence the arena is backed by the heap.
+        data_sync::SyncArena heapArena(pool);
+        std::pmr::string heapPaths(1024, 'x', heapArena.get());
+        EXPECT_FALSE(isPooled(heapPaths.data()));
+    }
+    EXPECT_EQ(pool.getFreeBuffersCount(), 1U);
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config_file_parser.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+/*
+ * Test when the configuration contains both the files and the directories
+ * along with the properties which are not required to sync.
+ */
+TEST(ConfigFileParserTest, TestFilesAndDirectories)
+{
+    const auto dataSyncCfgs = data_sync::config::parseConfigContent(R"(
+        {
+            "Version": { "Major": 1, "Tags": ["a", 1, null] },
+            "Files": [
+                {
+                    "Path": "/file/path/to/sync",
+                    "Description": "Add details about the data",
+                    "SyncDirection": "Active2Passive",
+                    "SyncType": "Periodic",
+                    "Periodicity": "PT1M10S",
+                    "RetryAttempts": 1,
+                    "RetryInterval": "PT1M",
+                    "QuietWindowInMsec": 500,
+                    "TransferMode": "Delta",
+                    "Priority": "High",
+                    "BandwidthLimitInKBps": 512,
+                    "Compression": "Zstd",
+                    "CompressionLevel": 3
+                }
+            ],
+            "Directories": [
+                {
+                    "Path": "/directory/path/to/sync",
+                    "Description": "Add details about the data",
+                    "SyncDirection": "Bidirectional",
+                    "SyncType": "Immediate",
+                    "ExcludeFilesList": ["/directory/path/to/sync/tmp"],
+                    "IncludeFilesList": ["/directory/path/to/sync/a",
+                                         "/directory/path/to/sync/b"]
+                }
+            ]
+        }
+    )");
+
+    ASSERT_EQ(dataSyncCfgs.size(), 2U);
+
+    const auto& fileCfg = dataSyncCfgs[0];
+    EXPECT_EQ(fileCfg._path, "/file/path/to/sync");
+    EXPECT_FALSE(fileCfg._isPathDir);
+    EXPECT_EQ(fileCfg._syncDirection,
+              data_sync::config::SyncDirection::Active2Passive);
+    EXPECT_EQ(fileCfg._syncType, data_sync::config::SyncType::Periodic);
+    EXPECT_EQ(fileCfg._periodicityInSec, std::chrono::seconds(70));
+    EXPECT_EQ(fileCfg._retry.value()._retryAttempts, 1);
+    EXPECT_EQ(fileCfg._retry.value()._retryIntervalInSec,
+              std::chrono::seconds(60));
+    EXPECT_EQ(fileCfg._quietWindowInMsec, std::chrono::milliseconds(500));
+    EXPECT_EQ(fileCfg._transferMode, data_sync::config::TransferMode::Delta);
+    EXPECT_EQ(fileCfg._priority, data_sync::config::Priority::High);
+    EXPECT_EQ(fileCfg._bandwidthLimitInKBps, 512U);
+    EXPECT_EQ(fileCfg._compression, data_sync::config::Compression::Zstd);
+    EXPECT_EQ(fileCfg._compressionLevel, 3);
+    EXPECT_EQ(fileCfg._excludeFileList, std::nullopt);
+    EXPECT_EQ(fileCfg._includeFileList, std::nullopt);
+
+    const auto& dirCfg = dataSyncCfgs[1];
+    EXPECT_EQ(dirCfg._path, "/directory/path/to/sync");
+    EXPECT_TRUE(dirCfg._isPathDir);
+    EXPECT_EQ(dirCfg._syncDirection,
+              data_sync::config::SyncDirection::Bidirectional);
+    EXPECT_EQ(dirCfg._syncType, data_sync::config::SyncType::Immediate);
+    EXPECT_EQ(dirCfg._periodicityInSec, std::nullopt);
+    EXPECT_EQ(dirCfg._retry, std::nullopt);
+    EXPECT_EQ(dirCfg._excludeFileList.value(),
+              std::vector<std::string>{"/directory/path/to/sync/tmp"});
+    EXPECT_EQ(dirCfg._includeFileList.value(),
+              (std::vector<std::string>{"/directory/path/to/sync/a",
+                                        "/directory/path/to/sync/b"}));
+    EXPECT_FALSE(dirCfg.isPathToSync("/directory/path/to/sync/tmp"));
+}
+
+/*
+ * Test when the configuration is not a valid JSON or has unexpected values
+ * for the properties required to sync.
+ */
+TEST(ConfigFileParserTest, TestInvalidConfiguration)
+{
+    using data_sync::config::parseConfigContent;
+
+    EXPECT_THROW(parseConfigContent(R"({ "Files": [ )"), std::invalid_argument);
+    EXPECT_THROW(parseConfigContent(R"(
+        { "Files": [ { "Path": "/file", "SyncType": "Immediate" } ] }
+    )"),
+                 std::invalid_argument);
+    EXPECT_THROW(parseConfigContent(R"(
+        { "Files": [ { "Path": 1, "SyncDirection": "Active2Passive",
+                       "SyncType": "Immediate" } ] }
+    )"),
+                 std::invalid_argument);
+    EXPECT_THROW(parseConfigContent(R"(
+        { "Directories": [ { "Path": "/dir", "SyncDirection": "Active2Passive",
+                             "SyncType": "Immediate",
+                             "ExcludeFilesList": [ 1 ] } ] }
+    )"),
+                 std::invalid_argument);
+    EXPECT_THROW(parseConfigContent(R"(
+        { "Files": [ { "Path": "/file", "SyncDirection": "Active2Passive",
+                       "SyncType": "Immediate", "RetryAttempts": 256,
+                       "RetryInterval": "PT1M" } ] }
+    )"),
+                 std::out_of_range);
+}
+
+/*
+ * Test that the files of the configuration directory are parsed in the
+ * order of their names, so that the same one of the paths configured more
+ * than once comes first on every start, and that the other files are
+ * parsed even if one fails.
+ */
+TEST(ConfigFileParserTest, TestDuplicatePathsInConfigDir)
+{
+    namespace fs = std::filesystem;
+
+    char tmpDir[] = "/tmp/config_file_parser_testXXXXXX";
+    const fs::path configDir = mkdtemp(tmpDir);
+    const auto writeFile = [&configDir](const std::string& name,
+                                        std::string_view syncType) {
+        std::ofstream file(configDir / name, std::ios::trunc);
+        file << R"({ "Files": [ { "Path": "/file/path/to/sync",
+                                  "SyncDirection": "Active2Passive",
+                                  "SyncType": ")"
+             << syncType << R"(", "Periodicity": "PT1M" } ] })";
+    };
+    writeFile("b.json", "Periodic");
+    writeFile("a.json", "Immediate");
+
+    bool isAllParsed = false;
+    auto dataSyncCfgs =
+        data_sync::config::parseConfigDir(configDir, isAllParsed);
+    EXPECT_TRUE(isAllParsed);
+    ASSERT_EQ(dataSyncCfgs.size(), 2U);
+    EXPECT_EQ(dataSyncCfgs[0]._path, dataSyncCfgs[1]._path);
+    EXPECT_EQ(dataSyncCfgs[0]._syncType,
+              data_sync::config::SyncType::Immediate);
+    EXPECT_EQ(dataSyncCfgs[1]._syncType,
+              data_sync::config::SyncType::Periodic);
+
+    std::ofstream(configDir / "0.json", std::ios::trunc) << "{ \"Files\": [";
+    dataSyncCfgs = data_sync::config::parseConfigDir(configDir, isAllParsed);
+    EXPECT_FALSE(isAllParsed);
+    ASSERT_EQ(dataSyncCfgs.size(), 2U);
+    EXPECT_EQ(dataSyncCfgs[0]._syncType,
+              data_sync::config::SyncType::Immediate);
+
+    fs::remove_all(configDir);
+}
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config_file_parser.hpp"
+#include "config_snapshot.hpp"
+#include "data_sync_config.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/**
+ * @brief The number of entries in each synthetic configuration file.
+ */
+constexpr std::size_t entriesPerFile = 100;
+
+/**
+ * @brief Get the JSON object of the given synthetic entry.
+ *
+ * @param[in] index - The index of the entry
+ *
+ * @return The JSON object of the entry.
+ */
+nlohmann::json getConfigJSON(std::size_t index)
+{
+    return {{"Path", "/var/lib/data-sync-benchmark/dir" +
+                         std::to_string(index)},
+            {"Description", "Synthetic data to benchmark the parsing"},
+            {"SyncDirection", "Active2Passive"},
+            {"SyncType", index % 2 == 0 ? "Immediate" : "Periodic"},
+            {"Periodicity", "PT1H10M30S"},
+            {"RetryAttempts", 3},
+            {"RetryInterval", "PT10S"},
+            {"ExcludeFilesList", {"*.tmp", "cache/*"}}};
+}
+
+/**
+ * @class SyntheticConfigDir
+ *
+ * @brief This class creates a temporary configuration directory of the
+ *        given number of entries, split into files of entriesPerFile
+ *        entries, and removes it at the end.
+ */
+class SyntheticConfigDir
+{
+  public:
+    SyntheticConfigDir(const SyntheticConfigDir&) = delete;
+    SyntheticConfigDir& operator=(const SyntheticConfigDir&) = delete;
+    SyntheticConfigDir(SyntheticConfigDir&&) = delete;
+    SyntheticConfigDir& operator=(SyntheticConfigDir&&) = delete;
+
+    explicit SyntheticConfigDir(std::size_t entriesCount)
+    {
+        char tmpDir[] = "/tmp/config_parsing_benchmarkXXXXXX";
+        _tmpDir = mkdtemp(tmpDir);
+        fs::create_directory(getConfigDir());
+
+        for (std::size_t first = 0; first < entriesCount;
+             first += entriesPerFile)
+        {
+            nlohmann::json directories = nlohmann::json::array();
+            for (std::size_t index = first;
+                 index < std::min(first + entriesPerFile, entriesCount);
+                 ++index)
+            {
+                directories.push_back(getConfigJSON(index));
+            }
+            std::ofstream file(getConfigDir() /
+                               ("config" + std::to_string(first) + ".json"));
+            file << nlohmann::json{{"Directories", directories}}.dump(4);
+        }
+    }
+
+    ~SyntheticConfigDir()
+    {
+        fs::remove_all(_tmpDir);
+    }
+
+    fs::path getConfigDir() const
+    {
+        return _tmpDir / "config";
+    }
+
+    fs::path getSnapshotFile() const
+    {
+        return _tmpDir / "config_snapshot.bin";
+    }
+
+  private:
+    fs::path _tmpDir;
+};
+
+} // namespace
+
+static void BM_DataSyncConfigFromJSON(benchmark::State& state)
+{
+    const auto configJSON = getConfigJSON(1);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            data_sync::config::DataSyncConfig(configJSON, true));
+    }
+}
+BENCHMARK(BM_DataSyncConfigFromJSON);
+
+/*
+ * The configuration files are parsed one after the other as done by
+ * Manager::parseConfiguration() when the snapshot is stale.
+ */
+static void BM_ParseConfigDir(benchmark::State& state)
+{
+    const SyntheticConfigDir configDir(
+        static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        std::vector<data_sync::config::DataSyncConfig> dataSyncConfigs;
+        for (const auto& configFile :
+             fs::directory_iterator(configDir.getConfigDir()))
+        {
+            std::ranges::move(
+                data_sync::config::parseConfigFile(configFile.path()),
+                std::back_inserter(dataSyncConfigs));
+        }
+        benchmark::DoNotOptimize(dataSyncConfigs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParseConfigDir)->Arg(10)->Arg(1000)->Arg(10000);
+
+/*
+ * The configuration is loaded from the snapshot as done by
+ * Manager::parseConfiguration() when the configuration files are unchanged.
+ */
+static void BM_LoadConfigSnapshot(benchmark::State& state)
+{
+    const SyntheticConfigDir configDir(
+        static_cast<std::size_t>(state.range(0)));
+    const data_sync::config::ConfigSnapshot snapshot(
+        configDir.getSnapshotFile());
+
+    std::vector<data_sync::config::DataSyncConfig> dataSyncConfigs;
+    for (const auto& configFile :
+         fs::directory_iterator(configDir.getConfigDir()))
+    {
+        std::ranges::move(
+            data_sync::config::parseConfigFile(configFile.path()),
+            std::back_inserter(dataSyncConfigs));
+    }
+    if (!snapshot.save(configDir.getConfigDir(), dataSyncConfigs))
+    {
+        state.SkipWithError("Failed to save the config snapshot");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(snapshot.load(configDir.getConfigDir()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadConfigSnapshot)->Arg(10)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "data_sync_config.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+/**
+ * @brief Get the given number of synthetic data sync configs, half of them
+ *        synced periodically, along with the indices of the periodic ones
+ *        the way the manager keeps them.
+ *
+ * @param[in] entriesCount - The number of configs
+ * @param[out] periodicIndices - The indices of the periodic configs
+ *
+ * @return The data sync configs.
+ */
+std::deque<data_sync::config::DataSyncConfig>
+    getDataSyncConfigs(std::size_t entriesCount,
+                       std::vector<std::size_t>& periodicIndices)
+{
+    std::deque<data_sync::config::DataSyncConfig> dataSyncConfigs;
+    for (std::size_t index = 0; index < entriesCount; ++index)
+    {
+        const auto dir = "/var/lib/data-sync-benchmark/entry" +
+                         std::to_string(index);
+        const bool isPeriodic = index % 2 == 1;
+        const nlohmann::json configJSON{
+            {"Path", dir},
+            {"SyncDirection", "Active2Passive"},
+            {"SyncType", isPeriodic ? "Periodic" : "Immediate"},
+            {"Periodicity", "PT1M"},
+            {"ExcludeFilesList", {dir + "/*.tmp"}},
+            {"IncludeFilesList", {dir + "/PersistData*"}}};
+        dataSyncConfigs.emplace_back(configJSON, true);
+        if (isPeriodic)
+        {
+            periodicIndices.push_back(index);
+        }
+    }
+    return dataSyncConfigs;
+}
+
+} // namespace
+
+/*
+ * The periodicity of every periodic data is read through the indices, as
+ * the manager does while arming the sync timers.
+ */
+static void BM_ScanPeriodicConfigs(benchmark::State& state)
+{
+    std::vector<std::size_t> periodicIndices;
+    const auto dataSyncConfigs = getDataSyncConfigs(
+        static_cast<std::size_t>(state.range(0)), periodicIndices);
+    for (auto _ : state)
+    {
+        std::chrono::seconds::rep totalPeriodicity = 0;
+        for (const auto index : periodicIndices)
+        {
+            totalPeriodicity +=
+                dataSyncConfigs[index]._periodicityInSec.value().count();
+        }
+        benchmark::DoNotOptimize(totalPeriodicity);
+    }
+}
+BENCHMARK(BM_ScanPeriodicConfigs)->Arg(10)->Arg(100)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
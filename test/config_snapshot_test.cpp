@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "config_snapshot.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class ConfigSnapshotTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpDir[] = "/tmp/config_snapshot_testXXXXXX";
+        _tmpDir = mkdtemp(tmpDir);
+        fs::create_directory(_tmpDir / "config");
+        writeFile(_tmpDir / "config" / "common.json", "{}");
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_tmpDir);
+    }
+
+    void writeFile(const fs::path& path, const std::string& content)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    std::vector<data_sync::config::DataSyncConfig> getDataSyncConfigs()
+    {
+        std::vector<data_sync::config::DataSyncConfig> dataSyncConfigs;
+        dataSyncConfigs.emplace_back(R"(
+            {
+                "Path": "/file/path/to/sync",
+                "SyncDirection": "Passive2Active",
+                "SyncType": "Periodic",
+                "Periodicity": "P1DT1M",
+                "RetryAttempts": 2,
+                "RetryInterval": "PT10S",
+                "QuietWindowInMsec": 0,
+                "TransferMode": "Whole",
+                "Priority": "Low",
+                "BandwidthLimitInKBps": 256,
+                "Compression": "LZ4"
+            }
+        )"_json,
+                                     false);
+        dataSyncConfigs.emplace_back(R"(
+            {
+                "Path": "/directory/path/to/sync",
+                "SyncDirection": "Bidirectional",
+                "SyncType": "Immediate",
+                "ExcludeFilesList": ["/directory/path/to/sync/*.tmp"],
+                "IncludeFilesList": ["/directory/path/to/sync/a"]
+            }
+        )"_json,
+                                     true);
+        return dataSyncConfigs;
+    }
+
+    fs::path _tmpDir;
+};
+
+/*
+ * Test that the data sync config loaded from the snapshot is the same as
+ * the saved one.
+ */
+TEST_F(ConfigSnapshotTest, TestSaveAndLoad)
+{
+    data_sync::config::ConfigSnapshot snapshot(_tmpDir / "persist" /
+                                               "snapshot.bin");
+    EXPECT_EQ(snapshot.load(_tmpDir / "config"), std::nullopt);
+
+    const auto savedConfigs = getDataSyncConfigs();
+    ASSERT_TRUE(snapshot.save(_tmpDir / "config", savedConfigs));
+
+    const auto loadedConfigs = snapshot.load(_tmpDir / "config");
+    ASSERT_TRUE(loadedConfigs.has_value());
+    ASSERT_EQ(loadedConfigs->size(), savedConfigs.size());
+    for (std::size_t index = 0; index < savedConfigs.size(); ++index)
+    {
+        const auto& saved = savedConfigs[index];
+        const auto& loaded = loadedConfigs->at(index);
+        EXPECT_EQ(loaded._path, saved._path);
+        EXPECT_EQ(loaded._isPathDir, saved._isPathDir);
+        EXPECT_EQ(loaded._syncDirection, saved._syncDirection);
+        EXPECT_EQ(loaded._syncType, saved._syncType);
+        EXPECT_EQ(loaded._periodicityInSec, saved._periodicityInSec);
+        EXPECT_EQ(loaded._retry.has_value(), saved._retry.has_value());
+        if (saved._retry.has_value())
+        {
+            EXPECT_EQ(loaded._retry->_retryAttempts,
+                      saved._retry->_retryAttempts);
+            EXPECT_EQ(loaded._retry->_retryIntervalInSec,
+                      saved._retry->_retryIntervalInSec);
+        }
+        EXPECT_EQ(loaded._quietWindowInMsec, saved._quietWindowInMsec);
+        EXPECT_EQ(loaded._transferMode, saved._transferMode);
+        EXPECT_EQ(loaded._priority, saved._priority);
+        EXPECT_EQ(loaded._bandwidthLimitInKBps, saved._bandwidthLimitInKBps);
+        EXPECT_EQ(loaded._compression, saved._compression);
+        EXPECT_EQ(loaded._compressionLevel, saved._compressionLevel);
+        EXPECT_EQ(loaded._excludeFileList, saved._excludeFileList);
+        EXPECT_EQ(loaded._includeFileList, saved._includeFileList);
+    }
+    EXPECT_FALSE(
+        loadedConfigs->at(1).isPathToSync("/directory/path/to/sync/x.tmp"));
+}
+
+/*
+ * Test that the snapshot is not used once a configuration file is changed,
+ * added or the snapshot is corrupted.
+ */
+TEST_F(ConfigSnapshotTest, TestStaleSnapshot)
+{
+    const auto snapshotFile = _tmpDir / "snapshot.bin";
+    data_sync::config::ConfigSnapshot snapshot(snapshotFile);
+
+    ASSERT_TRUE(snapshot.save(_tmpDir / "config", getDataSyncConfigs()));
+    writeFile(_tmpDir / "config" / "vendor.json", "{}");
+    EXPECT_EQ(snapshot.load(_tmpDir / "config"), std::nullopt);
+
+    ASSERT_TRUE(snapshot.save(_tmpDir / "config", getDataSyncConfigs()));
+    writeFile(_tmpDir / "config" / "common.json", "{ }");
+    EXPECT_EQ(snapshot.load(_tmpDir / "config"), std::nullopt);
+
+    ASSERT_TRUE(snapshot.save(_tmpDir / "config", getDataSyncConfigs()));
+    ASSERT_TRUE(snapshot.load(_tmpDir / "config").has_value());
+    fs::resize_file(snapshotFile, fs::file_size(snapshotFile) - 1);
+    EXPECT_EQ(snapshot.load(_tmpDir / "config"), std::nullopt);
+}
+
+/*
+ * Test that the snapshot saved by another build is not loaded even if the
+ * configuration files are unchanged.
+ */
+TEST_F(ConfigSnapshotTest, TestSnapshotOfAnotherBuild)
+{
+    const auto snapshotFile = _tmpDir / "snapshot.bin";
+    data_sync::config::ConfigSnapshot snapshot(snapshotFile);
+
+    ASSERT_TRUE(snapshot.save(_tmpDir / "config", getDataSyncConfigs()));
+    ASSERT_TRUE(snapshot.load(_tmpDir / "config").has_value());
+
+    // The parser identifier follows the magic, the version and its size.
+    std::fstream file(snapshotFile,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(3 * sizeof(std::uint32_t));
+    file.put('#');
+    file.close();
+    EXPECT_EQ(snapshot.load(_tmpDir / "config"), std::nullopt);
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "content_hash_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class ContentHashCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpDir[] = "/tmp/content_hash_cache_testXXXXXX";
+        _tmpDir = mkdtemp(tmpDir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_tmpDir);
+    }
+
+    void writeFile(const fs::path& path, const std::string& content)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    fs::path _tmpDir;
+};
+
+/*
+ * Test the XXH64 implementation against the reference hash values.
+ */
+TEST_F(ContentHashCacheTest, TestHashReferenceValues)
+{
+    EXPECT_EQ(data_sync::ContentHashCache::hash(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(data_sync::ContentHashCache::hash("a"), 0xD24EC4F1A98C6E5BULL);
+    EXPECT_EQ(data_sync::ContentHashCache::hash("abc"), 0x44BC2CF5AD770999ULL);
+}
+
+/*
+ * Test that hashing a file in chunks gives the same value as hashing its
+ * content at once.
+ */
+TEST_F(ContentHashCacheTest, TestFileHash)
+{
+    std::string content;
+    for (int i = 0; i < 10000; ++i)
+    {
+        content += std::to_string(i);
+    }
+    writeFile(_tmpDir / "file", content);
+
+    EXPECT_EQ(data_sync::ContentHashCache::hashFile(_tmpDir / "file"),
+              data_sync::ContentHashCache::hash(content));
+    EXPECT_EQ(data_sync::ContentHashCache::hashFile(_tmpDir / "missing"),
+              std::nullopt);
+}
+
+/*
+ * Test that the file rewritten with the same content is considered as
+ * unchanged and the cache survives a restart.
+ */
+TEST_F(ContentHashCacheTest, TestRewriteWithSameContent)
+{
+    const auto persistFile = _tmpDir / "persist" / "cache.json";
+    const auto path = _tmpDir / "file";
+    const auto dest = _tmpDir / "dest" / "file";
+
+    {
+        data_sync::ContentHashCache cache(persistFile);
+        writeFile(path, "state=on");
+        auto fileState = cache.getFileState(path);
+        ASSERT_TRUE(fileState.has_value());
+        EXPECT_FALSE(cache.isUnchanged(path, dest, fileState.value()));
+
+        cache.update(path, dest, fileState.value());
+        EXPECT_TRUE(cache.isDirty());
+        cache.persist();
+        EXPECT_FALSE(cache.isDirty());
+    }
+
+    data_sync::ContentHashCache cache(persistFile);
+
+    // Rewrite with the same content, the mtime changes but not the hash.
+    fs::last_write_time(path,
+                        fs::last_write_time(path) + std::chrono::hours(1));
+    auto fileState = cache.getFileState(path);
+    ASSERT_TRUE(fileState.has_value());
+    EXPECT_TRUE(cache.isUnchanged(path, dest, fileState.value()));
+
+    writeFile(path, "state=off");
+    fileState = cache.getFileState(path);
+    ASSERT_TRUE(fileState.has_value());
+    EXPECT_FALSE(cache.isUnchanged(path, dest, fileState.value()));
+}
+
+/*
+ * Test that removing a directory forgets all the files under it.
+ */
+TEST_F(ContentHashCacheTest, TestRemoveDirectory)
+{
+    data_sync::ContentHashCache cache(_tmpDir / "cache.json");
+    fs::create_directory(_tmpDir / "dir");
+    writeFile(_tmpDir / "dir" / "file", "data");
+    writeFile(_tmpDir / "dirfile", "data");
+
+    const auto dirFileState = cache.getFileState(_tmpDir / "dir" / "file");
+    const auto fileState = cache.getFileState(_tmpDir / "dirfile");
+    ASSERT_TRUE(dirFileState.has_value());
+    ASSERT_TRUE(fileState.has_value());
+    cache.update(_tmpDir / "dir" / "file", "bmc1:/dir/file",
+                 dirFileState.value());
+    cache.update(_tmpDir / "dirfile", "bmc1:/dirfile", fileState.value());
+
+    EXPECT_EQ(cache.getFileState(_tmpDir / "dir"), std::nullopt);
+    cache.remove(_tmpDir / "dir");
+
+    EXPECT_FALSE(cache.isUnchanged(_tmpDir / "dir" / "file", "bmc1:/dir/file",
+                                   dirFileState.value()));
+    EXPECT_TRUE(cache.isUnchanged(_tmpDir / "dirfile", "bmc1:/dirfile",
+                                  fileState.value()));
+}
+
+/*
+ * Test that a file synced to one destination is still to be synced to
+ * another destination.
+ */
+TEST_F(ContentHashCacheTest, TestPerDestination)
+{
+    const auto persistFile = _tmpDir / "cache.json";
+    const auto path = _tmpDir / "file";
+    writeFile(path, "data");
+
+    {
+        data_sync::ContentHashCache cache(persistFile);
+        const auto fileState = cache.getFileState(path);
+        ASSERT_TRUE(fileState.has_value());
+        cache.update(path, "bmc1:/file", fileState.value());
+        cache.persist();
+    }
+
+    data_sync::ContentHashCache cache(persistFile);
+    const auto fileState = cache.getFileState(path);
+    ASSERT_TRUE(fileState.has_value());
+    EXPECT_TRUE(cache.isUnchanged(path, "bmc1:/file", fileState.value()));
+    EXPECT_FALSE(cache.isUnchanged(path, "bmc2:/file", fileState.value()));
+
+    cache.update(path, "bmc2:/file", fileState.value());
+    EXPECT_TRUE(cache.isUnchanged(path, "bmc2:/file", fileState.value()));
+
+    cache.remove(path);
+    EXPECT_FALSE(cache.isUnchanged(path, "bmc1:/file", fileState.value()));
+    EXPECT_FALSE(cache.isUnchanged(path, "bmc2:/file", fileState.value()));
+}
@@ -9,6 +9,8 @@
 #include <filesystem>
 #include <fstream>
 #include <optional>
+#include <type_traits>
+#include <utility>
 
 #include <gtest/gtest.h>
 
@@ -31,9 +33,10 @@ TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithNoRetry)
 
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
 
     EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_FALSE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Active2Passive);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Immediate);
@@ -63,9 +66,10 @@ TEST(DataSyncConfigParserTest, TestPeriodicFileSyncWithRetry)
 
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
 
     EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_FALSE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Passive2Active);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Periodic);
@@ -94,9 +98,10 @@ TEST(DataSyncConfigParserTest, TestImmediateDirectorySyncWithNoRetry)
         }
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
 
     EXPECT_EQ(dataSyncConfig._path, "/directory/path/to/sync");
+    EXPECT_TRUE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Passive2Active);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Immediate);
@@ -124,9 +129,10 @@ TEST(DataSyncConfigParserTest, TestImmediateAndBidirectionalDirectorySync)
         }
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
 
     EXPECT_EQ(dataSyncConfig._path, "/directory/path/to/sync");
+    EXPECT_TRUE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Bidirectional);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Immediate);
@@ -138,7 +144,7 @@ TEST(DataSyncConfigParserTest, TestImmediateAndBidirectionalDirectorySync)
 
 /*
  * Test when the input JSON contains the details of the file to be synced
- * periodically where periodicity is not in expected format of 'PTxHxMxS'
+ * periodically where periodicity is not in expected format of 'PnDTnHnMnS'
  * Hence Periodicity will set to the default value of 60 seconds.
  */
 TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidPeriodicity)
@@ -150,16 +156,17 @@ TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidPeriodicity)
             "Description": "Add details about the data and purpose of the synchronization",
             "SyncDirection": "Active2Passive",
             "SyncType": "Periodic",
-            "Periodicity": "P1D",
+            "Periodicity": "P1Y",
             "RetryAttempts": 1,
             "RetryInterval": "PT1M"
         }
 
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
 
     EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_FALSE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Active2Passive);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Periodic);
@@ -173,7 +180,7 @@ TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidPeriodicity)
 
 /*
  * Test when the input JSON contains the details of the file to be synced
- * where RetryInterval is not in expected format of 'PTxHxMxS'
+ * where RetryInterval is not in expected format of 'PnDTnHnMnS'
  * Hence retryInterval will set to the default value as defined in config.h.
  */
 TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidRetryInterval)
@@ -187,14 +194,15 @@ TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidRetryInterval)
             "SyncType": "Periodic",
             "Periodicity": "PT30S",
             "RetryAttempts": 1,
-            "RetryInterval": "P1D"
+            "RetryInterval": "P1Y"
         }
 
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
 
     EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_FALSE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Active2Passive);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Periodic);
@@ -224,9 +232,10 @@ TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidSyncDirection)
 
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
 
     EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_FALSE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Active2Passive);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Immediate);
@@ -254,9 +263,10 @@ TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidSyncType)
 
     )"_json;
 
-    data_sync::config::DataSyncConfig dataSyncConfig(configJSON);
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
 
     EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_FALSE(dataSyncConfig._isPathDir);
     EXPECT_EQ(dataSyncConfig._syncDirection,
               data_sync::config::SyncDirection::Active2Passive);
     EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Immediate);
@@ -265,3 +275,287 @@ TEST(DataSyncConfigParserTest, TestFileSyncWithInvalidSyncType)
     EXPECT_EQ(dataSyncConfig._excludeFileList, std::nullopt);
     EXPECT_EQ(dataSyncConfig._includeFileList, std::nullopt);
 }
+
+/*
+ * Test when the input JSON contains the details of the directory to be synced
+ * immediately with the overriding quiet window to coalesce the changes.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateDirectorySyncWithQuietWindow)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "QuietWindowInMsec": 500
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
+
+    EXPECT_EQ(dataSyncConfig._path, "/directory/path/to/sync");
+    EXPECT_TRUE(dataSyncConfig._isPathDir);
+    EXPECT_EQ(dataSyncConfig._syncType, data_sync::config::SyncType::Immediate);
+    EXPECT_EQ(dataSyncConfig._quietWindowInMsec,
+              std::chrono::milliseconds(500));
+}
+
+/*
+ * Test when the input JSON contains the details of the file to be synced
+ * immediately by transferring only the changed blocks.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithDeltaTransfer)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "TransferMode": "Delta"
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._transferMode,
+              data_sync::config::TransferMode::Delta);
+    EXPECT_EQ(dataSyncConfig.getTransferModeInStr(), "Delta");
+}
+
+/*
+ * Test when the input JSON contains the details of the file to be synced
+ * immediately but with invalid TransferMode.
+ * Hence TransferMode will be left to the default behavior.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithInvalidTransferMode)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "TransferMode": "Blocks"
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._transferMode, std::nullopt);
+}
+
+/*
+ * Test when the input JSON contains the details of the file to be synced
+ * immediately with the high priority.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithHighPriority)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "Priority": "High"
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._priority, data_sync::config::Priority::High);
+    EXPECT_EQ(dataSyncConfig.getPriorityInStr(), "High");
+}
+
+/*
+ * Test when the input JSON contains the details of the file to be synced
+ * immediately but with invalid Priority.
+ * Hence Priority will be left to the default Normal.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithInvalidPriority)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "Priority": "Urgent"
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._priority, data_sync::config::Priority::Normal);
+}
+
+/*
+ * Test when the input JSON contains the details of the file to be synced
+ * immediately with the Zstd compression.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithCompression)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "Compression": "Zstd",
+            "CompressionLevel": 5
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._compression,
+              data_sync::config::Compression::Zstd);
+    EXPECT_EQ(dataSyncConfig.getCompressionInStr(), "Zstd");
+    EXPECT_EQ(dataSyncConfig._compressionLevel, 5);
+}
+
+/*
+ * Test when the input JSON contains the details of the file to be synced
+ * immediately but with invalid Compression.
+ * Hence the data will be transferred without compression.
+ */
+TEST(DataSyncConfigParserTest, TestImmediateFileSyncWithInvalidCompression)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/file/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "Compression": "gzip"
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, false);
+
+    EXPECT_EQ(dataSyncConfig._path, "/file/path/to/sync");
+    EXPECT_EQ(dataSyncConfig._compression, std::nullopt);
+}
+
+/*
+ * Test when the input JSON contains the details of the directory to be synced
+ * with the glob patterns in the exclude and include lists.
+ */
+TEST(DataSyncConfigParserTest, TestDirectorySyncWithGlobFilesList)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync",
+            "Description": "Add details about the data and purpose of the synchronization",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Immediate",
+            "ExcludeFilesList": ["/directory/path/to/sync/host*/*.tmp"],
+            "IncludeFilesList": ["/directory/path/to/sync/host*"]
+        }
+    )"_json;
+
+    data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
+
+    EXPECT_TRUE(dataSyncConfig.isPathToSync("/directory/path/to/sync"));
+    EXPECT_TRUE(dataSyncConfig.isPathToSync("/directory/path/to/sync/host0"));
+    EXPECT_TRUE(
+        dataSyncConfig.isPathToSync("/directory/path/to/sync/host0/file"));
+    EXPECT_FALSE(
+        dataSyncConfig.isPathToSync("/directory/path/to/sync/host0/file.tmp"));
+    EXPECT_FALSE(dataSyncConfig.isPathToSync("/directory/path/to/sync/bmc"));
+}
+
+/*
+ * Test that the data sync configs are compared on their configured values.
+ */
+TEST(DataSyncConfigParserTest, TestCompareDataSyncConfig)
+{
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync",
+            "SyncDirection": "Active2Passive",
+            "SyncType": "Periodic",
+            "Periodicity": "PT1M",
+            "RetryAttempts": 2,
+            "RetryInterval": "PT10S",
+            "ExcludeFilesList": ["/directory/path/to/sync/file.tmp"]
+        }
+    )"_json;
+
+    const data_sync::config::DataSyncConfig dataSyncConfig(configJSON, true);
+
+    EXPECT_EQ(dataSyncConfig,
+              data_sync::config::DataSyncConfig(configJSON, true));
+    EXPECT_NE(dataSyncConfig,
+              data_sync::config::DataSyncConfig(configJSON, false));
+
+    auto modifiedJSON = configJSON;
+    modifiedJSON["Periodicity"] = "PT2M";
+    EXPECT_NE(dataSyncConfig,
+              data_sync::config::DataSyncConfig(modifiedJSON, true));
+
+    modifiedJSON = configJSON;
+    modifiedJSON["RetryInterval"] = "PT20S";
+    EXPECT_NE(dataSyncConfig,
+              data_sync::config::DataSyncConfig(modifiedJSON, true));
+
+    modifiedJSON = configJSON;
+    modifiedJSON["ExcludeFilesList"] = nlohmann::json::array();
+    EXPECT_NE(dataSyncConfig,
+              data_sync::config::DataSyncConfig(modifiedJSON, true));
+}
+
+/*
+ * Test that the data sync configs differ on every optional property of the
+ * field table, and that the values in the form of the configuration file
+ * build the same data sync config.
+ */
+TEST(DataSyncConfigParserTest, TestCompareEveryProperty)
+{
+    using data_sync::config::DataSyncConfig;
+    using data_sync::config::RawDataSyncConfig;
+
+    const auto configJSON = R"(
+        {
+            "Path": "/directory/path/to/sync",
+            "SyncDirection": "Bidirectional",
+            "SyncType": "Periodic",
+            "Periodicity": "PT2M",
+            "RetryAttempts": 2,
+            "RetryInterval": "PT10S",
+            "QuietWindowInMsec": 500,
+            "TransferMode": "Delta",
+            "Priority": "High",
+            "BandwidthLimitInKBps": 512,
+            "Compression": "Zstd",
+            "CompressionLevel": 3,
+            "ExcludeFilesList": ["/directory/path/to/sync/file.tmp"],
+            "IncludeFilesList": ["/directory/path/to/sync/file"]
+        }
+    )"_json;
+
+    const DataSyncConfig dataSyncConfig(configJSON, true);
+    EXPECT_EQ(DataSyncConfig(dataSyncConfig.getRawDataSyncConfig(), true),
+              dataSyncConfig);
+
+    RawDataSyncConfig::forEachField(
+        [&configJSON, &dataSyncConfig](const char* name, auto field) {
+        using Field =
+            std::remove_cvref_t<decltype(std::declval<RawDataSyncConfig>().*
+                                         field)>;
+        if constexpr (!std::is_same_v<
+                          Field, data_sync::config::RawFieldValueT<Field>>)
+        {
+            auto modifiedJSON = configJSON;
+            modifiedJSON.erase(name);
+            EXPECT_NE(DataSyncConfig(modifiedJSON, true), dataSyncConfig)
+                << name;
+        }
+    });
+}
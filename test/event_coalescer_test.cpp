@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "event_coalescer.hpp"
+
+#include <chrono>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+/*
+ * Test that a burst of events of a path collapse into one take and only
+ * the first event asks the caller to start draining.
+ */
+TEST(EventCoalescerTest, TestBurstOfEventsCollapse)
+{
+    data_sync::EventCoalescer coalescer;
+    const auto start = data_sync::EventCoalescer::Clock::time_point{};
+
+    EXPECT_TRUE(coalescer.addEvents("/dir", {"/dir/file1"}, start));
+    EXPECT_FALSE(coalescer.addEvents("/dir", {"/dir/file1"}, start + 10ms));
+    EXPECT_FALSE(coalescer.addEvents("/dir", {"/dir/file2"}, start + 20ms));
+
+    // Not quiet yet as the last event is only 10ms old.
+    EXPECT_EQ(coalescer.timeToSettle("/dir", 100ms, 1s, start + 30ms), 90ms);
+
+    EXPECT_EQ(coalescer.timeToSettle("/dir", 100ms, 1s, start + 120ms), 0ms);
+    const auto changedPaths = coalescer.takeEvents("/dir");
+    EXPECT_EQ(changedPaths.size(), 2U);
+    EXPECT_TRUE(changedPaths.contains("/dir/file1"));
+    EXPECT_TRUE(changedPaths.contains("/dir/file2"));
+    EXPECT_EQ(coalescer.getCoalescedEventsCount(), 2U);
+
+    // No more events, hence the draining is finished.
+    EXPECT_EQ(coalescer.timeToSettle("/dir", 100ms, 1s, start + 130ms),
+              std::nullopt);
+    EXPECT_TRUE(coalescer.addEvents("/dir", {"/dir/file1"}, start + 140ms));
+}
+
+/*
+ * Test that the events received while syncing are kept and the draining
+ * continues with them.
+ */
+TEST(EventCoalescerTest, TestEventsWhileSyncing)
+{
+    data_sync::EventCoalescer coalescer;
+    const auto start = data_sync::EventCoalescer::Clock::time_point{};
+
+    EXPECT_TRUE(coalescer.addEvents("/file", {"/file"}, start));
+    EXPECT_EQ(coalescer.timeToSettle("/file", 0ms, 1s, start), 0ms);
+    coalescer.takeEvents("/file");
+
+    // An event while the sync is in progress
+    EXPECT_FALSE(coalescer.addEvents("/file", {"/file"}, start + 5ms));
+    EXPECT_EQ(coalescer.timeToSettle("/file", 0ms, 1s, start + 10ms), 0ms);
+    EXPECT_EQ(coalescer.takeEvents("/file").size(), 1U);
+    EXPECT_EQ(coalescer.timeToSettle("/file", 0ms, 1s, start + 15ms),
+              std::nullopt);
+    EXPECT_EQ(coalescer.getCoalescedEventsCount(), 0U);
+}
+
+/*
+ * Test that too many changed paths collapse into the configured path.
+ */
+TEST(EventCoalescerTest, TestTooManyChangedPaths)
+{
+    data_sync::EventCoalescer coalescer;
+
+    for (std::size_t i = 0;
+         i <= data_sync::EventCoalescer::maxChangedPaths; ++i)
+    {
+        coalescer.addEvents("/dir", {fs::path("/dir") / std::to_string(i)});
+    }
+    coalescer.addEvents("/dir", {"/dir/another"});
+
+    const auto changedPaths = coalescer.takeEvents("/dir");
+    EXPECT_EQ(changedPaths.size(), 1U);
+    EXPECT_TRUE(changedPaths.contains("/dir"));
+}
+
+/*
+ * Test that the time of the first event is kept across the burst and reset
+ * by the take.
+ */
+TEST(EventCoalescerTest, TestFirstEventTime)
+{
+    data_sync::EventCoalescer coalescer;
+    const auto start = data_sync::EventCoalescer::Clock::time_point{};
+
+    EXPECT_EQ(coalescer.getFirstEventTime("/dir"), std::nullopt);
+
+    coalescer.addEvents("/dir", {"/dir/file1"}, start + 10ms);
+    coalescer.addEvents("/dir", {"/dir/file2"}, start + 20ms);
+    EXPECT_EQ(coalescer.getFirstEventTime("/dir"), start + 10ms);
+
+    coalescer.takeEvents("/dir");
+    EXPECT_EQ(coalescer.getFirstEventTime("/dir"), std::nullopt);
+
+    coalescer.addEvents("/dir", {"/dir/file1"}, start + 50ms);
+    EXPECT_EQ(coalescer.getFirstEventTime("/dir"), start + 50ms);
+}
+
+/*
+ * Test that a path changing more often than the quiet window is still
+ * flushed once its first pending event reaches the maximum latency.
+ */
+TEST(EventCoalescerTest, TestSteadyEventStream)
+{
+    data_sync::EventCoalescer coalescer;
+    const auto start = data_sync::EventCoalescer::Clock::time_point{};
+
+    // An event every 50ms never leaves the path quiet for 100ms.
+    EXPECT_TRUE(coalescer.addEvents("/file", {"/file"}, start));
+    auto now = start;
+    for (; now < start + 500ms; now += 50ms)
+    {
+        coalescer.addEvents("/file", {"/file"}, now);
+        EXPECT_GT(coalescer.timeToSettle("/file", 100ms, 500ms, now), 0ms);
+    }
+
+    coalescer.addEvents("/file", {"/file"}, now);
+    EXPECT_EQ(coalescer.timeToSettle("/file", 100ms, 500ms, now), 0ms);
+    EXPECT_EQ(coalescer.takeEvents("/file").size(), 1U);
+
+    // The latency is counted afresh from the first event after the take.
+    coalescer.addEvents("/file", {"/file"}, now + 50ms);
+    EXPECT_EQ(coalescer.timeToSettle("/file", 100ms, 500ms, now + 100ms),
+              50ms);
+    EXPECT_EQ(coalescer.timeToSettle("/file", 100ms, 500ms, now + 150ms),
+              0ms);
+}
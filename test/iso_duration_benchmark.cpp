@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "iso_duration.hpp"
+
+#include <chrono>
+#include <optional>
+#include <regex>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+/**
+ * @brief The regex based parsing which is replaced by parseISODuration,
+ *        kept as the baseline to compare against.
+ */
+std::optional<std::chrono::seconds>
+    parseISODurationWithRegex(const std::string& timeIntervalInISO)
+{
+    std::smatch match;
+    std::regex isoDurationRegex("PT(([0-9]+)H)?(([0-9]+)M)?(([0-9]+)S)?");
+
+    if (std::regex_search(timeIntervalInISO, match, isoDurationRegex))
+    {
+        return (std::chrono::seconds(
+            (match.str(2).empty() ? 0 : (std::stoi(match.str(2)) * 60 * 60)) +
+            (match.str(4).empty() ? 0 : (std::stoi(match.str(4)) * 60)) +
+            (match.str(6).empty() ? 0 : std::stoi(match.str(6)))));
+    }
+    return std::nullopt;
+}
+
+const std::string duration{"PT1H10M30S"};
+
+} // namespace
+
+static void BM_ParseISODurationWithRegex(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(parseISODurationWithRegex(duration));
+    }
+}
+BENCHMARK(BM_ParseISODurationWithRegex);
+
+static void BM_ParseISODuration(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            data_sync::config::parseISODuration(duration));
+    }
+}
+BENCHMARK(BM_ParseISODuration);
+
+BENCHMARK_MAIN();
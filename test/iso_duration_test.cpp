@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "iso_duration.hpp"
+
+#include <gtest/gtest.h>
+
+using data_sync::config::parseISODuration;
+
+// The parser is usable at compile time.
+static_assert(parseISODuration("P1DT1H1M1S").value() ==
+              std::chrono::seconds(90061));
+static_assert(!parseISODuration("PT").has_value());
+
+/*
+ * Test the durations which follow the PnDTnHnMnS format.
+ */
+TEST(ISODurationParserTest, TestValidDurations)
+{
+    EXPECT_EQ(parseISODuration("PT1M10S").value(), std::chrono::seconds(70));
+    EXPECT_EQ(parseISODuration("PT2H").value(), std::chrono::hours(2));
+    EXPECT_EQ(parseISODuration("P1D").value(), std::chrono::days(1));
+    EXPECT_EQ(parseISODuration("P2DT30M").value(),
+              std::chrono::days(2) + std::chrono::minutes(30));
+    EXPECT_EQ(parseISODuration("PT0S").value(), std::chrono::seconds(0));
+    EXPECT_EQ(parseISODuration("PT90S").value(), std::chrono::seconds(90));
+}
+
+/*
+ * Test that the invalid durations are reported with the position of the
+ * failure.
+ */
+TEST(ISODurationParserTest, TestInvalidDurations)
+{
+    EXPECT_EQ(parseISODuration("").error()._position, 0U);
+    EXPECT_EQ(parseISODuration("T1M").error()._position, 0U);
+    EXPECT_EQ(parseISODuration("P").error()._position, 1U);
+    EXPECT_EQ(parseISODuration("PT").error()._position, 2U);
+    EXPECT_EQ(parseISODuration("P1DT").error()._position, 4U);
+    EXPECT_EQ(parseISODuration("P1Y").error()._position, 2U);
+    EXPECT_EQ(parseISODuration("P1M").error()._position, 2U);
+    EXPECT_EQ(parseISODuration("PT1D").error()._position, 3U);
+    EXPECT_EQ(parseISODuration("PT1S1M").error()._position, 5U);
+    EXPECT_EQ(parseISODuration("PT1H1H").error()._position, 5U);
+    EXPECT_EQ(parseISODuration("PTH").error()._position, 2U);
+    EXPECT_EQ(parseISODuration("PT10").error()._position, 4U);
+    EXPECT_EQ(parseISODuration("PT1.5S").error()._position, 3U);
+    EXPECT_EQ(parseISODuration("PT1MT1S").error()._position, 4U);
+    EXPECT_EQ(parseISODuration("PT99999999999999999999S").error()._position,
+              2U);
+    EXPECT_EQ(parseISODuration("P999999999999999999D").error()._position, 1U);
+}
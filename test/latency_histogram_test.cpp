@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "latency_histogram.hpp"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+/*
+ * Test that the latencies are counted in the buckets of powers of two
+ * microseconds.
+ */
+TEST(LatencyHistogramTest, TestBuckets)
+{
+    using data_sync::LatencyHistogram;
+
+    EXPECT_EQ(LatencyHistogram::getBucket(0us), 0U);
+    EXPECT_EQ(LatencyHistogram::getBucket(500ns), 0U);
+    EXPECT_EQ(LatencyHistogram::getBucket(1us), 1U);
+    EXPECT_EQ(LatencyHistogram::getBucket(2us), 2U);
+    EXPECT_EQ(LatencyHistogram::getBucket(3us), 2U);
+    EXPECT_EQ(LatencyHistogram::getBucket(4us), 3U);
+    EXPECT_EQ(LatencyHistogram::getBucket(1ms), 10U);
+    EXPECT_EQ(LatencyHistogram::getBucket(24h),
+              LatencyHistogram::bucketsCount - 1);
+}
+
+/*
+ * Test that the percentiles are reported as the upper bound of their
+ * buckets.
+ */
+TEST(LatencyHistogramTest, TestPercentile)
+{
+    data_sync::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.getPercentile(50), 0us);
+
+    for (int i = 0; i < 9; ++i)
+    {
+        histogram.record(3us);
+    }
+    histogram.record(1ms);
+
+    EXPECT_EQ(histogram.getTotalCount(), 10U);
+    EXPECT_EQ(histogram.getCounts()[2], 9U);
+    EXPECT_EQ(histogram.getCounts()[10], 1U);
+    EXPECT_EQ(histogram.getPercentile(0), 4us);
+    EXPECT_EQ(histogram.getPercentile(90), 4us);
+    EXPECT_EQ(histogram.getPercentile(99), 1024us);
+    EXPECT_EQ(histogram.getPercentile(100), 1024us);
+}
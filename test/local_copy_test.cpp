@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "local_copy.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class LocalCopyTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpDir[] = "/tmp/local_copy_testXXXXXX";
+        _tmpDir = mkdtemp(tmpDir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_tmpDir);
+    }
+
+    void writeFile(const fs::path& path, const std::string& content)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+
+    std::string readFile(const fs::path& path)
+    {
+        std::ifstream file(path);
+        return {std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>()};
+    }
+
+    std::vector<std::string> getFileNames(const fs::path& dir)
+    {
+        std::vector<std::string> fileNames;
+        for (const auto& entry : fs::directory_iterator(dir))
+        {
+            fileNames.emplace_back(entry.path().filename());
+        }
+        std::ranges::sort(fileNames);
+        return fileNames;
+    }
+
+    fs::path _tmpDir;
+};
+
+/*
+ * Test that the file is copied into the missing destination directories
+ * along with its permissions and modification time.
+ */
+TEST_F(LocalCopyTest, TestCopyFile)
+{
+    const auto source = _tmpDir / "source";
+    const auto dest = _tmpDir / "dest" / "dir" / "file";
+    const std::string content(1024 * 1024 + 7, 'x');
+    writeFile(source, content);
+    fs::permissions(source, fs::perms::owner_read | fs::perms::owner_write);
+    fs::last_write_time(source, fs::file_time_type{} + std::chrono::hours(1));
+
+    EXPECT_FALSE(data_sync::local_copy::copyFile(source, dest));
+
+    EXPECT_EQ(readFile(dest), content);
+    EXPECT_EQ(fs::status(dest).permissions(), fs::status(source).permissions());
+    EXPECT_EQ(fs::last_write_time(dest), fs::last_write_time(source));
+    EXPECT_EQ(getFileNames(dest.parent_path()),
+              std::vector<std::string>{"file"});
+}
+
+/*
+ * Test that the copy replaces the content of the existing destination.
+ */
+TEST_F(LocalCopyTest, TestReplaceFile)
+{
+    const auto source = _tmpDir / "source";
+    const auto dest = _tmpDir / "dest";
+    writeFile(source, "new");
+    writeFile(dest, "old content");
+
+    EXPECT_FALSE(data_sync::local_copy::copyFile(source, dest));
+    EXPECT_EQ(readFile(dest), "new");
+}
+
+/*
+ * Test the failure to copy a missing file and the removal of the
+ * destination.
+ */
+TEST_F(LocalCopyTest, TestMissingSource)
+{
+    const auto dest = _tmpDir / "dest" / "file";
+    fs::create_directories(_tmpDir / "dest");
+    writeFile(dest, "content");
+
+    EXPECT_TRUE(data_sync::local_copy::copyFile(_tmpDir / "missing", dest));
+    EXPECT_EQ(readFile(dest), "content");
+
+    EXPECT_FALSE(data_sync::local_copy::removePath(_tmpDir / "dest"));
+    EXPECT_FALSE(fs::exists(_tmpDir / "dest"));
+    EXPECT_FALSE(data_sync::local_copy::removePath(_tmpDir / "dest"));
+}
+
+/*
+ * Test that the staged files are applied together on commit and that the
+ * destination keeps the old content till then.
+ */
+TEST_F(LocalCopyTest, TestAtomicApply)
+{
+    writeFile(_tmpDir / "source1", "new1");
+    writeFile(_tmpDir / "source2", "new2");
+    fs::create_directories(_tmpDir / "dest");
+    writeFile(_tmpDir / "dest" / "file1", "old1");
+    writeFile(_tmpDir / "dest" / "removed", "old");
+
+    data_sync::local_copy::AtomicApply atomicApply;
+    EXPECT_FALSE(
+        atomicApply.stage(_tmpDir / "source1", _tmpDir / "dest" / "file1"));
+    EXPECT_FALSE(
+        atomicApply.stage(_tmpDir / "source2", _tmpDir / "dest" / "file2"));
+    atomicApply.stageRemoval(_tmpDir / "dest" / "removed");
+
+    EXPECT_EQ(readFile(_tmpDir / "dest" / "file1"), "old1");
+    EXPECT_FALSE(fs::exists(_tmpDir / "dest" / "file2"));
+    EXPECT_TRUE(fs::exists(_tmpDir / "dest" / "removed"));
+
+    EXPECT_FALSE(atomicApply.commit());
+    EXPECT_EQ(readFile(_tmpDir / "dest" / "file1"), "new1");
+    EXPECT_EQ(readFile(_tmpDir / "dest" / "file2"), "new2");
+    EXPECT_FALSE(fs::exists(_tmpDir / "dest" / "removed"));
+    EXPECT_EQ(getFileNames(_tmpDir / "dest"),
+              (std::vector<std::string>{"file1", "file2"}));
+}
+
+/*
+ * Test that the staged files are discarded if not committed.
+ */
+TEST_F(LocalCopyTest, TestDiscardUncommitted)
+{
+    writeFile(_tmpDir / "source", "new");
+    {
+        data_sync::local_copy::AtomicApply atomicApply;
+        EXPECT_FALSE(atomicApply.stage(_tmpDir / "source", _tmpDir / "dest"));
+        EXPECT_EQ(getFileNames(_tmpDir).size(), 2U);
+    }
+    EXPECT_EQ(getFileNames(_tmpDir), std::vector<std::string>{"source"});
+}
+
+/*
+ * Test that the staging file doesn't clobber the files next to the
+ * destination, even if named like a temporary file.
+ */
+TEST_F(LocalCopyTest, TestUniqueStagingFile)
+{
+    writeFile(_tmpDir / "source", "new");
+    writeFile(_tmpDir / "dest.tmp", "unrelated");
+
+    EXPECT_FALSE(data_sync::local_copy::copyFile(_tmpDir / "source",
+                                                 _tmpDir / "dest"));
+    EXPECT_EQ(readFile(_tmpDir / "dest"), "new");
+    EXPECT_EQ(readFile(_tmpDir / "dest.tmp"), "unrelated");
+    EXPECT_EQ(getFileNames(_tmpDir),
+              (std::vector<std::string>{"dest", "dest.tmp", "source"}));
+}
+
+/*
+ * Test that the setuid and setgid bits of the file are kept.
+ */
+TEST_F(LocalCopyTest, TestSetuidBits)
+{
+    const auto source = _tmpDir / "source";
+    writeFile(source, "#!/bin/sh");
+    ASSERT_EQ(chmod(source.c_str(), S_ISUID | S_ISGID | 0755), 0);
+
+    EXPECT_FALSE(data_sync::local_copy::copyFile(source, _tmpDir / "dest"));
+    EXPECT_EQ(fs::status(_tmpDir / "dest").permissions(),
+              fs::status(source).permissions());
+}
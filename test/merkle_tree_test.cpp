@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "merkle_tree.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+/*
+ * Test that the trees with the same files have the same root hash, in any
+ * order of the updates.
+ */
+TEST(MerkleTreeTest, TestRootHashOfSameFiles)
+{
+    data_sync::MerkleTree tree("/dir/");
+    tree.update("/dir/a/file1", 1);
+    tree.update("/dir/a/file2", 2);
+    tree.update("/dir/file3", 3);
+
+    data_sync::MerkleTree otherTree("/dir");
+    otherTree.update("/dir/file3", 3);
+    otherTree.update("/dir/a/file2", 2);
+    otherTree.update("/dir/a/file1", 1);
+
+    EXPECT_EQ(tree.getRootHash(), otherTree.getRootHash());
+    EXPECT_TRUE(tree.diff(otherTree).empty());
+
+    otherTree.update("/dir/a/file1", 4);
+    EXPECT_NE(tree.getRootHash(), otherTree.getRootHash());
+}
+
+/*
+ * Test that the diff descends only into the differing subtrees and reports
+ * the topmost differing paths.
+ */
+TEST(MerkleTreeTest, TestDiffOfChangedSubtrees)
+{
+    data_sync::MerkleTree tree("/dir");
+    tree.update("/dir/a/file1", 1);
+    tree.update("/dir/b/c/file2", 2);
+    tree.update("/dir/b/file3", 3);
+
+    auto otherTree = tree;
+    otherTree.update("/dir/b/c/file2", 5);
+    otherTree.update("/dir/d/file4", 4);
+    otherTree.update("/dir/a/file1", std::nullopt);
+
+    auto diffPaths = tree.diff(otherTree);
+    std::ranges::sort(diffPaths);
+    EXPECT_EQ(diffPaths,
+              (std::vector<fs::path>{"/dir/a", "/dir/b/c/file2", "/dir/d"}));
+
+    // The removal prunes the emptied directories.
+    tree.update("/dir/a/file1", std::nullopt);
+    tree.update("/dir/d/file4", 4);
+    EXPECT_EQ(tree.diff(otherTree),
+              (std::vector<fs::path>{"/dir/b/c/file2"}));
+
+    // The paths outside the root are ignored.
+    tree.update("/other/file", 6);
+    EXPECT_EQ(tree.diff(otherTree).size(), 1U);
+}
+
+/*
+ * Test that the assign copies the given subtree of the other tree.
+ */
+TEST(MerkleTreeTest, TestAssignSubtree)
+{
+    data_sync::MerkleTree syncedTree("/dir");
+    syncedTree.update("/dir/a/file1", 1);
+    syncedTree.update("/dir/b/file2", 2);
+
+    data_sync::MerkleTree currentTree("/dir");
+    currentTree.update("/dir/a/file1", 3);
+    currentTree.update("/dir/c/file4", 4);
+
+    syncedTree.assign("/dir/a", currentTree);
+    syncedTree.assign("/dir/b", currentTree);
+    EXPECT_EQ(syncedTree.diff(currentTree),
+              (std::vector<fs::path>{"/dir/c"}));
+
+    syncedTree.assign("/dir", currentTree);
+    EXPECT_EQ(syncedTree.getRootHash(), currentTree.getRootHash());
+}
+
+/*
+ * Test that a file replaced by a directory and vice versa is reported.
+ */
+TEST(MerkleTreeTest, TestFileReplacedByDirectory)
+{
+    data_sync::MerkleTree tree("/dir");
+    tree.update("/dir/a", 1);
+
+    data_sync::MerkleTree otherTree("/dir");
+    otherTree.update("/dir/a/file1", 1);
+
+    EXPECT_EQ(tree.diff(otherTree), (std::vector<fs::path>{"/dir/a"}));
+
+    tree.update("/dir/a/file1", 1);
+    EXPECT_TRUE(tree.diff(otherTree).empty());
+}
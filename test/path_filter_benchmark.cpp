@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "data_sync_config.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+/**
+ * @brief The configured directory of the synthetic data.
+ */
+const std::string configuredDir{"/var/lib/data-sync-benchmark"};
+
+/**
+ * @brief Get the data sync config of the synthetic data with the given
+ *        number of patterns in each of its exclude and include lists.
+ *
+ * @param[in] patternsCount - The number of patterns in each list
+ *
+ * @return The data sync config.
+ */
+data_sync::config::DataSyncConfig getDataSyncConfig(std::size_t patternsCount)
+{
+    std::vector<std::string> excludeFileList;
+    std::vector<std::string> includeFileList;
+    for (std::size_t index = 0; index < patternsCount; ++index)
+    {
+        const auto hostDir = configuredDir + "/host" + std::to_string(index);
+        excludeFileList.push_back(hostDir + "/*.tmp");
+        includeFileList.push_back(hostDir + "/PersistData*");
+    }
+
+    const nlohmann::json configJSON{{"Path", configuredDir},
+                                    {"SyncDirection", "Active2Passive"},
+                                    {"SyncType", "Immediate"},
+                                    {"ExcludeFilesList", excludeFileList},
+                                    {"IncludeFilesList", includeFileList}};
+    return {configJSON, true};
+}
+
+} // namespace
+
+/*
+ * The path is included by the last pattern of the include list.
+ */
+static void BM_IsPathToSyncIncluded(benchmark::State& state)
+{
+    const auto patternsCount = static_cast<std::size_t>(state.range(0));
+    const auto dataSyncConfig = getDataSyncConfig(patternsCount);
+    const std::string path = configuredDir + "/host" +
+                             std::to_string(patternsCount - 1) +
+                             "/PersistData.json";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dataSyncConfig.isPathToSync(path));
+    }
+}
+BENCHMARK(BM_IsPathToSyncIncluded)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+/*
+ * The path is excluded by the last pattern of the exclude list.
+ */
+static void BM_IsPathToSyncExcluded(benchmark::State& state)
+{
+    const auto patternsCount = static_cast<std::size_t>(state.range(0));
+    const auto dataSyncConfig = getDataSyncConfig(patternsCount);
+    const std::string path = configuredDir + "/host" +
+                             std::to_string(patternsCount - 1) + "/file.tmp";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dataSyncConfig.isPathToSync(path));
+    }
+}
+BENCHMARK(BM_IsPathToSyncExcluded)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+/*
+ * The path matches none of the patterns.
+ */
+static void BM_IsPathToSyncNotIncluded(benchmark::State& state)
+{
+    const auto dataSyncConfig =
+        getDataSyncConfig(static_cast<std::size_t>(state.range(0)));
+    const std::string path = configuredDir + "/bmc/file";
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(dataSyncConfig.isPathToSync(path));
+    }
+}
+BENCHMARK(BM_IsPathToSyncNotIncluded)->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
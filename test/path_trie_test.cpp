@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "path_trie.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+/*
+ * Test that a path matches the deepest pattern which is the same as or a
+ * parent of the path.
+ */
+TEST(PathTrieTest, TestLongestPrefix)
+{
+    data_sync::PathTrie<std::string> trie;
+    EXPECT_TRUE(trie.empty());
+
+    trie.insert("/var/lib/data", "data");
+    trie.insert("/var/lib/data/sub/", "sub");
+    EXPECT_FALSE(trie.empty());
+
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/data"), "data");
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/data/file"), "data");
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/data/sub/file"), "sub");
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib"), nullptr);
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib/data2"), nullptr);
+}
+
+/*
+ * Test that a glob pattern component matches exactly one path component.
+ */
+TEST(PathTrieTest, TestGlobPattern)
+{
+    data_sync::PathTrie<std::string> trie;
+    trie.insert("/var/lib/data/*.json", "json");
+    trie.insert("/var/lib/host[0-9]/state", "state");
+
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/data/cfg.json"), "json");
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/host1/state/file"), "state");
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib/data/cfg.txt"), nullptr);
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib/data/.hidden.json"), nullptr);
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib/hostA/state"), nullptr);
+}
+
+/*
+ * Test that the parent directories of the patterns are identified.
+ */
+TEST(PathTrieTest, TestPatternUnder)
+{
+    data_sync::PathTrie<std::string> trie;
+    trie.insert("/var/lib/host*/state", "state");
+
+    EXPECT_TRUE(trie.hasPatternUnder("/"));
+    EXPECT_TRUE(trie.hasPatternUnder("/var/lib"));
+    EXPECT_TRUE(trie.hasPatternUnder("/var/lib/host0"));
+    EXPECT_TRUE(trie.hasPatternUnder("/var/lib/host0/state"));
+    EXPECT_FALSE(trie.hasPatternUnder("/var/lib/host0/state/file"));
+    EXPECT_FALSE(trie.hasPatternUnder("/var/lib/other"));
+}
+
+/*
+ * Test that a literal path matches only itself even if it has the glob
+ * special characters, and that the path added first is kept.
+ */
+TEST(PathTrieTest, TestLiteralPath)
+{
+    data_sync::PathTrie<std::string> trie;
+    EXPECT_TRUE(trie.insertLiteral("/var/lib/data[1]", "data"));
+    EXPECT_TRUE(trie.insertLiteral("/var/lib/*", "star"));
+    EXPECT_FALSE(trie.insertLiteral("/var/lib/data[1]/", "duplicate"));
+
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/data[1]/file"), "data");
+    EXPECT_EQ(*trie.findLongestPrefix("/var/lib/*"), "star");
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib/data1"), nullptr);
+    EXPECT_EQ(trie.findLongestPrefix("/var/lib/other"), nullptr);
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "peer_connection.hpp"
+
+#include <optional>
+
+#include <gtest/gtest.h>
+
+/*
+ * Test that the host is taken from the destinations reached over SSH.
+ */
+TEST(PeerConnectionTest, TestRemoteHost)
+{
+    using data_sync::PeerConnection;
+
+    EXPECT_EQ(PeerConnection::getRemoteHost("bmc1:/"), "bmc1");
+    EXPECT_EQ(PeerConnection::getRemoteHost("root@bmc1:/var/lib/"),
+              "root@bmc1");
+    EXPECT_EQ(PeerConnection::getRemoteHost("root@[fe80::1]:/"),
+              "root@fe80::1");
+}
+
+/*
+ * Test that the local destinations and the rsync daemons are not reached
+ * over SSH.
+ */
+TEST(PeerConnectionTest, TestNoRemoteHost)
+{
+    using data_sync::PeerConnection;
+
+    EXPECT_EQ(PeerConnection::getRemoteHost("/tmp/peer/"), std::nullopt);
+    EXPECT_EQ(PeerConnection::getRemoteHost("./peer:dir/"), std::nullopt);
+    EXPECT_EQ(PeerConnection::getRemoteHost("bmc1::module/"), std::nullopt);
+    EXPECT_EQ(PeerConnection::getRemoteHost("rsync://bmc1/module/"),
+              std::nullopt);
+    EXPECT_EQ(PeerConnection::getRemoteHost(":/"), std::nullopt);
+}
+
+/*
+ * Test that the sibling BMC is taken as back only when the connection comes
+ * up after being down, and not when it comes up at the start.
+ */
+TEST(PeerConnectionTest, TestPeerBack)
+{
+    data_sync::PeerPresence presence;
+
+    EXPECT_FALSE(presence.setUp());
+    EXPECT_TRUE(presence.isUp());
+    EXPECT_FALSE(presence.setUp());
+
+    presence.setDown();
+    EXPECT_FALSE(presence.isUp());
+    EXPECT_TRUE(presence.setUp());
+    EXPECT_FALSE(presence.setUp());
+
+    // The failed attempts while the sibling BMC is away count once.
+    presence.setDown();
+    presence.setDown();
+    EXPECT_TRUE(presence.setUp());
+}
+
+/*
+ * Test that the sibling BMC which is away at the start is taken as back
+ * once the connection comes up.
+ */
+TEST(PeerConnectionTest, TestPeerBackAfterStart)
+{
+    data_sync::PeerPresence presence;
+
+    presence.setDown();
+    EXPECT_TRUE(presence.setUp());
+}
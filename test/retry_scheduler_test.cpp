@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "retry_scheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+/*
+ * Test that the retry delay backs off exponentially with the jitter and
+ * stops once the retry attempts are done.
+ */
+TEST(RetrySchedulerTest, TestExponentialBackoff)
+{
+    const data_sync::config::Retry retry(10, 5s);
+    std::minstd_rand engine{};
+
+    for (std::uint8_t retryCount = 0; retryCount < 10; ++retryCount)
+    {
+        const auto shift = std::min<unsigned>(
+            retryCount, data_sync::RetryScheduler::maxBackoffShift);
+        const auto backoff = 5s * (1U << shift);
+
+        const auto delay =
+            data_sync::RetryScheduler::getRetryDelay(retry, retryCount, engine);
+        ASSERT_TRUE(delay.has_value());
+        EXPECT_LE(*delay, backoff);
+        EXPECT_GE(*delay, backoff / 2);
+    }
+
+    EXPECT_EQ(data_sync::RetryScheduler::getRetryDelay(retry, 10, engine),
+              std::nullopt);
+}
+
+/*
+ * Test that the retries are jittered instead of firing together.
+ */
+TEST(RetrySchedulerTest, TestJitteredDelay)
+{
+    const data_sync::config::Retry retry(3, 60s);
+    std::minstd_rand engine{};
+
+    const auto first =
+        data_sync::RetryScheduler::getRetryDelay(retry, 0, engine);
+    bool isJittered = false;
+    for (int count = 0; count < 10 && !isJittered; ++count)
+    {
+        isJittered = data_sync::RetryScheduler::getRetryDelay(retry, 0,
+                                                              engine) != first;
+    }
+    EXPECT_TRUE(isJittered);
+}
+
+/*
+ * Test that the retry attempts of zero means no retries.
+ */
+TEST(RetrySchedulerTest, TestNoRetries)
+{
+    const data_sync::config::Retry retry(0, 5s);
+    std::minstd_rand engine{};
+
+    EXPECT_EQ(data_sync::RetryScheduler::getRetryDelay(retry, 0, engine),
+              std::nullopt);
+}
+
+/*
+ * Test that only the allowed number of retries are in progress at a time.
+ */
+TEST(RetrySchedulerTest, TestParallelRetriesCap)
+{
+    data_sync::RetryScheduler scheduler(2);
+
+    EXPECT_TRUE(scheduler.tryAcquire());
+    EXPECT_TRUE(scheduler.tryAcquire());
+    EXPECT_FALSE(scheduler.tryAcquire());
+    EXPECT_EQ(scheduler.getActiveRetries(), 2U);
+
+    scheduler.release();
+    EXPECT_TRUE(scheduler.tryAcquire());
+}
+
+/*
+ * Test that the released slots wake the waiters one at a time, in the
+ * order they wait.
+ */
+TEST(RetrySchedulerTest, TestSlotWaiters)
+{
+    data_sync::RetryScheduler scheduler(1);
+    std::vector<int> wokenWaiters;
+
+    scheduler.waitForSlot([&wokenWaiters]() { wokenWaiters.push_back(0); });
+    EXPECT_EQ(wokenWaiters, std::vector<int>{0});
+
+    EXPECT_TRUE(scheduler.tryAcquire());
+    scheduler.waitForSlot([&wokenWaiters]() { wokenWaiters.push_back(1); });
+    scheduler.waitForSlot([&wokenWaiters]() { wokenWaiters.push_back(2); });
+    EXPECT_EQ(wokenWaiters.size(), 1U);
+
+    scheduler.release();
+    EXPECT_EQ(wokenWaiters, (std::vector<int>{0, 1}));
+
+    // The woken waiter takes the slot as it starts the retry.
+    EXPECT_TRUE(scheduler.tryAcquire());
+    scheduler.release();
+    EXPECT_EQ(wokenWaiters, (std::vector<int>{0, 1, 2}));
+
+    scheduler.release();
+    EXPECT_EQ(wokenWaiters.size(), 3U);
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sync_journal.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class SyncJournalTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpDir[] = "/tmp/sync_journal_testXXXXXX";
+        _tmpDir = mkdtemp(tmpDir);
+        _journalFile = fs::path(_tmpDir) / "sync_journal";
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_tmpDir);
+    }
+
+    fs::path _tmpDir;
+    fs::path _journalFile;
+};
+
+/*
+ * Test that only the syncs which are not ended are replayed as interrupted
+ * on the next start.
+ */
+TEST_F(SyncJournalTest, TestReplayInterruptedSyncs)
+{
+    std::uint64_t interruptedId{0};
+    {
+        data_sync::SyncJournal journal(_journalFile);
+        EXPECT_TRUE(journal.getInterruptedSyncs().empty());
+
+        const auto syncedId = journal.begin("/dir", {"/dir/file1"});
+        interruptedId =
+            journal.begin("/file", std::vector<fs::path>{"/file"});
+        journal.end(syncedId);
+        EXPECT_EQ(journal.getInProgressCount(), 1U);
+    }
+
+    data_sync::SyncJournal journal(_journalFile);
+    const auto& interruptedSyncs = journal.getInterruptedSyncs();
+    ASSERT_EQ(interruptedSyncs.size(), 1U);
+    EXPECT_EQ(interruptedSyncs.at(interruptedId),
+              (data_sync::JournalEntry{"/file", {"/file"}}));
+
+    // The new syncs don't reuse the ids of the previous run.
+    EXPECT_GT(journal.begin("/dir", {"/dir/file2"}), interruptedId);
+
+    journal.end(interruptedId);
+    EXPECT_TRUE(journal.getInterruptedSyncs().empty());
+}
+
+/*
+ * Test that a record torn by the restart is ignored while replaying.
+ */
+TEST_F(SyncJournalTest, TestTornRecord)
+{
+    {
+        data_sync::SyncJournal journal(_journalFile);
+        journal.begin("/file", std::vector<fs::path>{"/file"});
+    }
+    {
+        std::ofstream file(_journalFile, std::ios::app);
+        file << R"({"Op":"End","Id)";
+    }
+
+    data_sync::SyncJournal journal(_journalFile);
+    EXPECT_EQ(journal.getInterruptedSyncs().size(), 1U);
+}
+
+/*
+ * Test that the journal is compacted to the syncs in progress once it
+ * grows beyond the limit.
+ */
+TEST_F(SyncJournalTest, TestCompaction)
+{
+    data_sync::SyncJournal journal(_journalFile);
+    const auto inProgressId =
+        journal.begin("/file", std::vector<fs::path>{"/file"});
+    for (std::size_t count = 0; count < data_sync::SyncJournal::maxRecords;
+         ++count)
+    {
+        journal.end(journal.begin("/dir", {"/dir/file"}));
+    }
+
+    std::ifstream file(_journalFile);
+    std::size_t linesCount = 0;
+    for (std::string line; std::getline(file, line);)
+    {
+        linesCount++;
+    }
+    EXPECT_LT(linesCount, data_sync::SyncJournal::maxRecords);
+
+    data_sync::SyncJournal replayedJournal(_journalFile);
+    ASSERT_EQ(replayedJournal.getInterruptedSyncs().size(), 1U);
+    EXPECT_TRUE(replayedJournal.getInterruptedSyncs().contains(inProgressId));
+}
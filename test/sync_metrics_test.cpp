@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sync_metrics.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+/*
+ * Test that the outcome of the syncs is counted per data and in the total.
+ */
+TEST(SyncMetricsTest, TestRecordSync)
+{
+    data_sync::SyncMetrics syncMetrics(3);
+
+    syncMetrics.recordSync(0, 20ms, true);
+    syncMetrics.recordSync(2, 30ms, false);
+    syncMetrics.recordRetry(2);
+    syncMetrics.recordSync(0, 10ms, true);
+
+    EXPECT_EQ(syncMetrics.getCounters(0),
+              (data_sync::SyncCounters{2, 0, 0, 0, 10}));
+    EXPECT_EQ(syncMetrics.getCounters(1), data_sync::SyncCounters{});
+    EXPECT_EQ(syncMetrics.getCounters(2),
+              (data_sync::SyncCounters{0, 1, 1, 0, 30}));
+    EXPECT_EQ(syncMetrics.getTotalCounters(),
+              (data_sync::SyncCounters{2, 1, 1, 0, 10}));
+}
+
+/*
+ * Test that the bytes of a batch are apportioned across the data of the
+ * batch as per their weights and add up to the total.
+ */
+TEST(SyncMetricsTest, TestRecordSentBytes)
+{
+    data_sync::SyncMetrics syncMetrics(3);
+
+    syncMetrics.recordSentBytes({0, 1}, {1, 3}, 100);
+    syncMetrics.recordSentBytes({1}, {0}, 50);
+
+    EXPECT_EQ(syncMetrics.getCounters(0)._sentBytes, 25U);
+    EXPECT_EQ(syncMetrics.getCounters(1)._sentBytes, 125U);
+    EXPECT_EQ(syncMetrics.getCounters(2)._sentBytes, 0U);
+    EXPECT_EQ(syncMetrics.getTotalCounters()._sentBytes, 150U);
+
+    // The data without weights share the bytes equally, without losing the
+    // bytes to the rounding.
+    syncMetrics.recordSentBytes({0, 1, 2}, {0, 0, 0}, 10);
+    EXPECT_EQ(syncMetrics.getCounters(0)._sentBytes, 28U);
+    EXPECT_EQ(syncMetrics.getCounters(1)._sentBytes, 128U);
+    EXPECT_EQ(syncMetrics.getCounters(2)._sentBytes, 4U);
+    EXPECT_EQ(syncMetrics.getTotalCounters()._sentBytes, 160U);
+}
+
+/*
+ * Test that the changed data are taken once per batch of changes.
+ */
+TEST(SyncMetricsTest, TestTakeChanges)
+{
+    data_sync::SyncMetrics syncMetrics(4);
+    EXPECT_TRUE(syncMetrics.takeChangedEntries().empty());
+    EXPECT_FALSE(syncMetrics.takeTotalChanged());
+
+    syncMetrics.recordSync(3, 1ms, true);
+    syncMetrics.recordRetry(1);
+    syncMetrics.recordSync(3, 1ms, true);
+    EXPECT_EQ(syncMetrics.takeChangedEntries(),
+              (std::vector<std::size_t>{1, 3}));
+    EXPECT_TRUE(syncMetrics.takeTotalChanged());
+    EXPECT_TRUE(syncMetrics.takeChangedEntries().empty());
+    EXPECT_FALSE(syncMetrics.takeTotalChanged());
+
+    // The gauges change only the total.
+    syncMetrics.setQueueDepth(2);
+    syncMetrics.setCoalescedEventCount(5);
+    EXPECT_TRUE(syncMetrics.takeChangedEntries().empty());
+    EXPECT_TRUE(syncMetrics.takeTotalChanged());
+    EXPECT_EQ(syncMetrics.getQueueDepth(), 2U);
+    EXPECT_EQ(syncMetrics.getCoalescedEventCount(), 5U);
+
+    syncMetrics.setQueueDepth(2);
+    EXPECT_FALSE(syncMetrics.takeTotalChanged());
+}
+
+/*
+ * Test that the stage latencies are counted per stage.
+ */
+TEST(SyncMetricsTest, TestRecordStageLatency)
+{
+    using data_sync::SyncStage;
+    data_sync::SyncMetrics syncMetrics(1);
+
+    syncMetrics.recordStageLatency(SyncStage::Transfer, 3ms);
+    syncMetrics.recordStageLatency(SyncStage::Transfer, 5ms);
+    syncMetrics.recordStageLatency(SyncStage::Queue, 1ms);
+
+    EXPECT_EQ(syncMetrics.getStageLatencies(SyncStage::Transfer)
+                  .getTotalCount(),
+              2U);
+    EXPECT_EQ(syncMetrics.getStageLatencies(SyncStage::Queue).getTotalCount(),
+              1U);
+    EXPECT_EQ(syncMetrics.getStageLatencies(SyncStage::Filter)
+                  .getTotalCount(),
+              0U);
+    EXPECT_TRUE(syncMetrics.takeTotalChanged());
+    EXPECT_TRUE(syncMetrics.takeChangedEntries().empty());
+}
+
+/*
+ * Test that the counters of the existing data are kept while growing for
+ * the added data.
+ */
+TEST(SyncMetricsTest, TestResize)
+{
+    data_sync::SyncMetrics syncMetrics(1);
+    syncMetrics.recordSync(0, 20ms, true);
+
+    syncMetrics.resize(3);
+    syncMetrics.recordSync(2, 10ms, false);
+
+    EXPECT_EQ(syncMetrics.getCounters(0),
+              (data_sync::SyncCounters{1, 0, 0, 0, 20}));
+    EXPECT_EQ(syncMetrics.getCounters(1), data_sync::SyncCounters{});
+    EXPECT_EQ(syncMetrics.getCounters(2),
+              (data_sync::SyncCounters{0, 1, 0, 0, 10}));
+    EXPECT_EQ(syncMetrics.takeChangedEntries(),
+              (std::vector<std::size_t>{0, 2}));
+}
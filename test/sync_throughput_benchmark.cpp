@@ -0,0 +1,358 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * The end-to-end benchmark of the sync throughput, which runs the manager
+ * against a simulated sibling BMC and reports the events and bytes synced
+ * per second and the latency from a change to its replication.
+ *
+ * Usage: sync-throughput-benchmark [--local-copy]
+ *                                   [<sync dest root> <peer dir>]
+ *
+ * By default the sibling BMC is a local directory, which the manager syncs
+ * through rsync as it would to a sibling BMC. Give --local-copy to measure
+ * the local copies the manager makes to a local dest root instead. To sync
+ * over the network, give a remote sync dest root of a loopback peer, e.g.
+ * 'localhost:/tmp/peer' or the address of a network namespace, along with
+ * the local directory at which that dest root is seen from this BMC.
+ *
+ * The benchmark hosts the BMC role as Active on the default bus, so run it
+ * on a private bus, e.g.
+ *   dbus-run-session -- sh -c \
+ *     'DBUS_SYSTEM_BUS_ADDRESS=$DBUS_SESSION_BUS_ADDRESS \
+ *      sync-throughput-benchmark'
+ *
+ * @note The manager keeps its state under the temporary directory of the
+ *       benchmark, leaving that of the installed service untouched.
+ */
+
+#include "manager.hpp"
+
+#include <sdbusplus/async.hpp>
+#include <sdbusplus/server/object.hpp>
+#include <xyz/openbmc_project/State/BMC/Redundancy/server.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief The size of the header, which makes each write of a file unique.
+ */
+constexpr std::size_t headerSize = 16;
+
+/**
+ * @brief The time to wait for a workload to be replicated.
+ */
+constexpr auto replicationTimeout = 120s;
+
+/**
+ * @brief The workload of a benchmark run.
+ */
+struct Workload
+{
+    /**
+     * @brief The name of the workload.
+     */
+    std::string _name;
+
+    /**
+     * @brief The configured directories which the workload changes.
+     */
+    std::vector<std::string> _dirs;
+
+    /**
+     * @brief The number of files in each directory.
+     */
+    std::size_t _filesPerDir;
+
+    /**
+     * @brief The size of each file.
+     */
+    std::size_t _fileSize;
+
+    /**
+     * @brief The number of times each file is rewritten in a row.
+     */
+    std::size_t _rewrites;
+};
+
+/**
+ * @brief The workloads to run, in order.
+ */
+const std::vector<Workload> workloads{
+    {"ManyTinyFiles", {"tiny"}, 2000, 64, 1},
+    {"FewBigFiles", {"big"}, 4, 16 * 1024 * 1024, 1},
+    {"BurstRewrites",
+     {"host0-PersistData", "host1-PersistData", "host2-PersistData",
+      "host3-PersistData"},
+     16,
+     512,
+     32}};
+
+/**
+ * @brief The expected content of a written file.
+ */
+struct WrittenFile
+{
+    std::string _header;
+    std::uintmax_t _size;
+    Clock::time_point _writeTime;
+};
+
+/**
+ * @brief A helper API to write the given generation of a file.
+ *
+ * @param[in] path - The file to write
+ * @param[in] size - The size of the file
+ * @param[in] generation - The generation which makes the content unique
+ *
+ * @return The expected content of the file.
+ */
+WrittenFile writeFile(const fs::path& path, std::size_t size,
+                      std::size_t generation)
+{
+    auto content = std::format("{:0{}}", generation, headerSize);
+    content.resize(std::max(size, headerSize), 'x');
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(content.data(),
+                   static_cast<std::streamsize>(content.size()));
+    }
+    return {content.substr(0, headerSize), content.size(), Clock::now()};
+}
+
+/**
+ * @brief A helper API to check whether the given file is replicated.
+ *
+ * @param[in] peerPath - The file on the sibling BMC
+ * @param[in] writtenFile - The expected content of the file
+ *
+ * @return true if the file has the expected content.
+ */
+bool isReplicated(const fs::path& peerPath, const WrittenFile& writtenFile)
+{
+    std::error_code ec;
+    if (fs::file_size(peerPath, ec) != writtenFile._size || ec)
+    {
+        return false;
+    }
+
+    // The files are renamed in place once synced, so the size and the
+    // header identify the content.
+    std::string header(headerSize, '\0');
+    std::ifstream file(peerPath, std::ios::binary);
+    file.read(header.data(), static_cast<std::streamsize>(headerSize));
+    return file && header == writtenFile._header;
+}
+
+/**
+ * @brief A helper API to get the given percentile of the sorted latencies.
+ *
+ * @param[in] latencies - The sorted latencies
+ * @param[in] percentile - The percentile in the range [0, 100]
+ *
+ * @return The latency in milliseconds.
+ */
+double getPercentile(const std::vector<Clock::duration>& latencies,
+                     double percentile)
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+    const auto index = static_cast<std::size_t>(
+        percentile / 100 * static_cast<double>(latencies.size() - 1));
+    return std::chrono::duration<double, std::milli>(latencies[index]).count();
+}
+
+/**
+ * @brief A helper API to run the given workload and report its results.
+ *
+ * @param[in] workload - The workload to run
+ * @param[in] sourceRoot - The directory of the configured directories
+ * @param[in] peerDir - The local directory of the sync dest root
+ *
+ * @return true if the whole workload is replicated.
+ */
+bool runWorkload(const Workload& workload, const fs::path& sourceRoot,
+                 const fs::path& peerDir)
+{
+    std::map<fs::path, WrittenFile> pendingFiles;
+    std::size_t eventsCount = 0;
+    std::uintmax_t bytesCount = 0;
+
+    const auto startTime = Clock::now();
+    for (std::size_t rewrite = 0; rewrite < workload._rewrites; ++rewrite)
+    {
+        for (const auto& dir : workload._dirs)
+        {
+            for (std::size_t index = 0; index < workload._filesPerDir; ++index)
+            {
+                const auto path = sourceRoot / dir /
+                                  ("file" + std::to_string(index));
+                pendingFiles.insert_or_assign(
+                    path, writeFile(path, workload._fileSize, rewrite));
+                eventsCount++;
+            }
+        }
+    }
+    for (const auto& [path, writtenFile] : pendingFiles)
+    {
+        bytesCount += writtenFile._size;
+    }
+
+    std::vector<Clock::duration> latencies;
+    auto endTime = Clock::now();
+    while (!pendingFiles.empty() && endTime - startTime < replicationTimeout)
+    {
+        std::this_thread::sleep_for(1ms);
+        endTime = Clock::now();
+        std::erase_if(pendingFiles, [&](const auto& entry) {
+            const auto& [path, writtenFile] = entry;
+            if (!isReplicated(peerDir / path.relative_path(), writtenFile))
+            {
+                return false;
+            }
+            latencies.push_back(endTime - writtenFile._writeTime);
+            return true;
+        });
+    }
+    std::ranges::sort(latencies);
+
+    const auto elapsedInSec =
+        std::chrono::duration<double>(endTime - startTime).count();
+    std::cout << std::format(
+        "{:<16} {:>12.0f} {:>14.0f} {:>10.1f} {:>10.1f} {}\n", workload._name,
+        static_cast<double>(eventsCount) / elapsedInSec,
+        static_cast<double>(bytesCount) / elapsedInSec,
+        getPercentile(latencies, 50), getPercentile(latencies, 99),
+        pendingFiles.empty()
+            ? std::string{}
+            : std::format("({} files not replicated)", pendingFiles.size()));
+    return pendingFiles.empty();
+}
+
+/**
+ * @brief A helper API to write the data sync configuration of all the
+ *        workloads.
+ *
+ * @param[in] configFile - The configuration file to write
+ * @param[in] sourceRoot - The directory of the configured directories
+ *
+ * @return NULL
+ */
+void writeConfig(const fs::path& configFile, const fs::path& sourceRoot)
+{
+    std::string directories;
+    for (const auto& workload : workloads)
+    {
+        for (const auto& dir : workload._dirs)
+        {
+            fs::create_directories(sourceRoot / dir);
+            directories += std::format(
+                R"({}{{"Path": "{}", "SyncDirection": "Active2Passive",)"
+                R"( "SyncType": "Immediate"}})",
+                directories.empty() ? "" : ",", (sourceRoot / dir).string());
+        }
+    }
+    std::ofstream file(configFile, std::ios::trunc);
+    file << std::format(R"({{"Directories": [{}]}})", directories);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    using BMCRedundancy =
+        sdbusplus::server::xyz::openbmc_project::state::bmc::Redundancy;
+
+    const std::string_view programName = argv[0];
+    const bool isLocalCopyAllowed =
+        argc > 1 && std::string_view(argv[1]) == "--local-copy";
+    if (isLocalCopyAllowed)
+    {
+        --argc;
+        ++argv;
+    }
+    if (argc != 1 && argc != 3)
+    {
+        std::cerr << "Usage: " << programName
+                  << " [--local-copy] [<sync dest root> <peer dir>]\n";
+        return EXIT_FAILURE;
+    }
+
+    char tmpDir[] = "/tmp/sync_throughput_benchmarkXXXXXX";
+    const fs::path benchmarkDir = mkdtemp(tmpDir);
+    const auto sourceRoot = benchmarkDir / "source";
+    const auto configDir = benchmarkDir / "config";
+    const fs::path peerDir =
+        argc == 3 ? fs::path(argv[2]) : benchmarkDir / "peer";
+    const std::string syncDestRoot =
+        argc == 3 ? std::string(argv[1]) : peerDir.string() + "/";
+
+    fs::create_directories(configDir);
+    fs::create_directories(peerDir);
+    writeConfig(configDir / "benchmark.json", sourceRoot);
+
+    sdbusplus::async::context ctx;
+
+    // The role is hosted before the manager starts, which asks for it.
+    sdbusplus::server::object_t<BMCRedundancy> bmcRedundancy(
+        ctx.get_bus(), "/xyz/openbmc_project/state/bmc0");
+    bmcRedundancy.role(BMCRedundancy::Role::Active);
+    ctx.request_name(BMCRedundancy::interface);
+
+    data_sync::Manager manager{ctx, configDir, syncDestRoot,
+                               benchmarkDir / "persist", isLocalCopyAllowed};
+
+    std::atomic<bool> isDone{false};
+    bool isAllReplicated = true;
+    std::thread workloadThread([&] {
+        // Let the manager arm the watches and finish the full sync.
+        std::this_thread::sleep_for(2s);
+
+        std::cout << std::format("{:<16} {:>12} {:>14} {:>10} {:>10}\n",
+                                 "Workload", "Events/sec", "Bytes/sec",
+                                 "p50 (ms)", "p99 (ms)");
+        for (const auto& workload : workloads)
+        {
+            isAllReplicated &= runWorkload(workload, sourceRoot, peerDir);
+        }
+        isDone = true;
+    });
+
+    // clang-tidy currently mangles this into something unreadable
+    // NOLINTNEXTLINE
+    ctx.spawn([](sdbusplus::async::context& ctx,
+                 std::atomic<bool>& isDone) -> sdbusplus::async::task<> {
+        while (!isDone)
+        {
+            co_await sdbusplus::async::sleep_for(ctx, 100ms);
+        }
+        ctx.request_stop();
+    }(ctx, isDone));
+
+    ctx.run();
+    workloadThread.join();
+    fs::remove_all(benchmarkDir);
+
+    return isAllReplicated ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "timer_wheel.hpp"
+
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+using data_sync::TimerWheel;
+
+/*
+ * Test that the timers scheduled at the same tick expire together.
+ */
+TEST(TimerWheelTest, TestTimersExpireInBatch)
+{
+    TimerWheel timerWheel;
+    timerWheel.schedule(1, 60);
+    timerWheel.schedule(2, 60);
+    timerWheel.schedule(3, 61);
+
+    EXPECT_EQ(timerWheel.size(), 3U);
+    EXPECT_EQ(timerWheel.getNextWakeupTick(), 60U);
+    EXPECT_TRUE(timerWheel.advanceTo(59).empty());
+
+    EXPECT_EQ(timerWheel.advanceTo(60), (std::vector<std::size_t>{1, 2}));
+    EXPECT_EQ(timerWheel.getNextWakeupTick(), 61U);
+    EXPECT_EQ(timerWheel.advanceTo(100), (std::vector<std::size_t>{3}));
+    EXPECT_EQ(timerWheel.size(), 0U);
+    EXPECT_EQ(timerWheel.getNextWakeupTick(), std::nullopt);
+}
+
+/*
+ * Test that the timers in the higher levels are cascaded and expire
+ * at the exact tick.
+ */
+TEST(TimerWheelTest, TestTimersInHigherLevels)
+{
+    TimerWheel timerWheel;
+    timerWheel.advanceTo(63);
+    timerWheel.schedule(1, 4095);
+    timerWheel.schedule(2, 3600);
+    timerWheel.schedule(3, 86400);
+
+    EXPECT_EQ(timerWheel.advanceTo(63 + 3599).size(), 0U);
+    EXPECT_EQ(timerWheel.advanceTo(63 + 3600), (std::vector<std::size_t>{2}));
+    EXPECT_EQ(timerWheel.advanceTo(63 + 4094).size(), 0U);
+    EXPECT_EQ(timerWheel.advanceTo(63 + 4095), (std::vector<std::size_t>{1}));
+    EXPECT_EQ(timerWheel.advanceTo(63 + 86399).size(), 0U);
+    EXPECT_EQ(timerWheel.advanceTo(63 + 86400), (std::vector<std::size_t>{3}));
+}
+
+/*
+ * Test that the timers beyond the range of the wheel expire at
+ * the exact tick.
+ */
+TEST(TimerWheelTest, TestTimersBeyondRange)
+{
+    TimerWheel timerWheel;
+    constexpr TimerWheel::Tick farTick = 20'000'000;
+    timerWheel.schedule(1, farTick);
+
+    EXPECT_EQ(timerWheel.advanceTo(farTick - 1).size(), 0U);
+    EXPECT_EQ(timerWheel.advanceTo(farTick), (std::vector<std::size_t>{1}));
+}
+
+/*
+ * Test that the randomly scheduled timers expire exactly at their tick
+ * while advancing the wheel to its wakeup ticks.
+ */
+TEST(TimerWheelTest, TestRandomTimers)
+{
+    TimerWheel timerWheel;
+    std::mt19937 engine(42);
+    std::uniform_int_distribution<TimerWheel::Tick> delay(1, 300'000);
+    std::map<std::size_t, TimerWheel::Tick> expiryTicks;
+
+    for (std::size_t timerId = 0; timerId < 500; ++timerId)
+    {
+        const auto ticks = delay(engine);
+        timerWheel.schedule(timerId, ticks);
+        expiryTicks[timerId] = ticks;
+    }
+
+    while (auto wakeupTick = timerWheel.getNextWakeupTick())
+    {
+        for (auto timerId : timerWheel.advanceTo(*wakeupTick))
+        {
+            EXPECT_EQ(expiryTicks[timerId], *wakeupTick);
+            expiryTicks.erase(timerId);
+        }
+    }
+    EXPECT_TRUE(expiryTicks.empty());
+}
+
+/*
+ * Test that the cancelled timers don't expire, in any level of the wheel.
+ */
+TEST(TimerWheelTest, TestCancel)
+{
+    TimerWheel timerWheel;
+    timerWheel.schedule(1, 10);
+    timerWheel.schedule(2, 10);
+    timerWheel.schedule(1, 100'000);
+
+    EXPECT_TRUE(timerWheel.cancel(1));
+    EXPECT_FALSE(timerWheel.cancel(1));
+    EXPECT_EQ(timerWheel.size(), 1U);
+
+    EXPECT_EQ(timerWheel.advanceTo(100'000), (std::vector<std::size_t>{2}));
+    EXPECT_EQ(timerWheel.getNextWakeupTick(), std::nullopt);
+}
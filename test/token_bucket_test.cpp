@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "token_bucket.hpp"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+/*
+ * Test that the traffic beyond the available tokens has to wait till the
+ * debt is refilled at the configured rate.
+ */
+TEST(TokenBucketTest, TestWaitForTheDebt)
+{
+    const auto start = data_sync::TokenBucket::Clock::time_point{};
+    data_sync::TokenBucket bucket(1000, 1000, start);
+
+    EXPECT_FALSE(bucket.isUnlimited());
+    EXPECT_EQ(bucket.timeToAvailable(start), 0s);
+
+    // The burst is used and 500 tokens are borrowed.
+    bucket.consume(1500, start, start);
+    EXPECT_EQ(bucket.timeToAvailable(start), 500ms);
+    EXPECT_EQ(bucket.timeToAvailable(start + 200ms), 300ms);
+    EXPECT_EQ(bucket.timeToAvailable(start + 500ms), 0s);
+}
+
+/*
+ * Test that the tokens don't accumulate beyond the burst while idle.
+ */
+TEST(TokenBucketTest, TestRefillUptoTheBurst)
+{
+    const auto start = data_sync::TokenBucket::Clock::time_point{};
+    data_sync::TokenBucket bucket(1000, 2000, start);
+
+    bucket.consume(2000, start, start);
+    EXPECT_EQ(bucket.timeToAvailable(start + 1h), 0s);
+
+    // Only the burst is available after the long idle time.
+    bucket.consume(3000, start + 1h, start + 1h);
+    EXPECT_EQ(bucket.timeToAvailable(start + 1h), 1s);
+}
+
+/*
+ * Test that the back to back traffic at the rate isn't throttled, as the
+ * tokens refilled while the traffic runs aren't capped by the burst.
+ */
+TEST(TokenBucketTest, TestBackToBackTraffic)
+{
+    const auto start = data_sync::TokenBucket::Clock::time_point{};
+    data_sync::TokenBucket bucket(1000, 1000, start);
+
+    auto transferStart = start;
+    for (int count = 0; count < 5; ++count)
+    {
+        EXPECT_EQ(bucket.timeToAvailable(transferStart), 0s);
+
+        // Each transfer takes 3s at the rate.
+        bucket.consume(3000, transferStart, transferStart + 3s);
+        transferStart += 3s;
+    }
+
+    // Sending faster than the rate still leaves a debt.
+    bucket.consume(3000, transferStart, transferStart + 1s);
+    EXPECT_EQ(bucket.timeToAvailable(transferStart + 1s), 1s);
+}
+
+/*
+ * Test that the bucket with zero rate doesn't limit the traffic.
+ */
+TEST(TokenBucketTest, TestUnlimitedRate)
+{
+    const auto start = data_sync::TokenBucket::Clock::time_point{};
+    data_sync::TokenBucket bucket(0, 0, start);
+
+    EXPECT_TRUE(bucket.isUnlimited());
+    bucket.consume(1'000'000, start, start);
+    EXPECT_EQ(bucket.timeToAvailable(start), 0s);
+}
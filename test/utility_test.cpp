@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "utility.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+
+class UtilityTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        char tmpDir[] = "/tmp/utility_testXXXXXX";
+        _tmpDir = mkdtemp(tmpDir);
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_tmpDir);
+    }
+
+    std::string readFile(const fs::path& path)
+    {
+        std::ifstream file(path);
+        return {std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>()};
+    }
+
+    fs::path _tmpDir;
+};
+
+/*
+ * Test that the file is written into the missing directories and replaced
+ * without leaving the temporary file behind.
+ */
+TEST_F(UtilityTest, TestWriteFileAtomically)
+{
+    const auto file = _tmpDir / "dir" / "file";
+
+    EXPECT_FALSE(data_sync::utility::writeFileAtomically(file, "old"));
+    EXPECT_EQ(readFile(file), "old");
+
+    EXPECT_FALSE(data_sync::utility::writeFileAtomically(file, "new content"));
+    EXPECT_EQ(readFile(file), "new content");
+    EXPECT_EQ(std::distance(fs::directory_iterator(file.parent_path()),
+                            fs::directory_iterator{}),
+              1);
+}
+
+/*
+ * Test the failure to write into a directory which can't be created.
+ */
+TEST_F(UtilityTest, TestWriteFileAtomicallyFailure)
+{
+    std::ofstream(_tmpDir / "notdir") << "file";
+
+    EXPECT_TRUE(data_sync::utility::writeFileAtomically(
+        _tmpDir / "notdir" / "file", "content"));
+    EXPECT_EQ(readFile(_tmpDir / "notdir"), "file");
+}
+
+/*
+ * Test that the destinations in the rsync format are told apart as rsync
+ * does, and that the remote host is given as taken by SSH.
+ */
+TEST(RsyncDestTest, TestParseRsyncDest)
+{
+    using data_sync::utility::parseRsyncDest;
+    using Kind = data_sync::utility::RsyncDest::Kind;
+
+    EXPECT_EQ(parseRsyncDest("/tmp/peer/")._kind, Kind::Local);
+    EXPECT_EQ(parseRsyncDest("./peer:dir/")._kind, Kind::Local);
+    EXPECT_EQ(parseRsyncDest(":/")._kind, Kind::Local);
+    EXPECT_EQ(parseRsyncDest("bmc1::module/")._kind, Kind::Daemon);
+    EXPECT_EQ(parseRsyncDest("rsync://bmc1/module/")._kind, Kind::Daemon);
+    EXPECT_EQ(parseRsyncDest("[fe80::1]::module/")._kind, Kind::Daemon);
+
+    auto rsyncDest = parseRsyncDest("root@bmc1:/var/lib/");
+    EXPECT_EQ(rsyncDest._kind, Kind::Shell);
+    EXPECT_EQ(rsyncDest._remoteHost, "root@bmc1");
+
+    rsyncDest = parseRsyncDest("root@[fe80::1]:/");
+    EXPECT_EQ(rsyncDest._kind, Kind::Shell);
+    EXPECT_EQ(rsyncDest._remoteHost, "root@fe80::1");
+}
+
+/*
+ * Test that the total is split as per the weights, equally without any
+ * weight, and that the shares add up to the total.
+ */
+TEST(ApportionTest, TestApportion)
+{
+    using data_sync::utility::apportion;
+    using Shares = std::vector<std::uint64_t>;
+
+    EXPECT_EQ(apportion(100, {1, 3}), (Shares{25, 75}));
+    EXPECT_EQ(apportion(100, {0, 0, 0}), (Shares{33, 33, 34}));
+    EXPECT_EQ(apportion(10, {1, 1, 1}), (Shares{3, 3, 4}));
+    EXPECT_EQ(apportion(0, {5, 5}), (Shares{0, 0}));
+    EXPECT_EQ(apportion(100, {7}), Shares{100});
+    EXPECT_TRUE(apportion(100, {}).empty());
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "version_vector.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace fs = std::filesystem;
+using Order = data_sync::VersionVector::Order;
+
+/*
+ * Test the order of the versions changed on one or both BMCs.
+ */
+TEST(VersionVectorTest, TestCompare)
+{
+    data_sync::VersionVector base;
+    base.increment("bmc0");
+
+    auto local = base;
+    local.increment("bmc0");
+    auto remote = base;
+    remote.increment("bmc1");
+
+    EXPECT_EQ(base.compare(base), Order::Equal);
+    EXPECT_EQ(base.compare(local), Order::Before);
+    EXPECT_EQ(local.compare(base), Order::After);
+    EXPECT_EQ(local.compare(remote), Order::Concurrent);
+    EXPECT_EQ(data_sync::VersionVector{}.compare(remote), Order::Before);
+
+    // The merged version includes the changes of both.
+    auto merged = local;
+    merged.merge(remote);
+    EXPECT_EQ(merged.compare(local), Order::After);
+    EXPECT_EQ(merged.compare(remote), Order::After);
+}
+
+/*
+ * Test that both BMCs pick the same winner of the concurrent versions.
+ */
+TEST(VersionVectorTest, TestConflictWinner)
+{
+    data_sync::VersionVector local;
+    local.increment("bmc0");
+    local.increment("bmc0");
+    data_sync::VersionVector remote;
+    remote.increment("bmc1");
+
+    // More changes win.
+    EXPECT_TRUE(local.isPreferredOver(remote));
+    EXPECT_FALSE(remote.isPreferredOver(local));
+
+    // The tie is broken deterministically.
+    remote.increment("bmc1");
+    EXPECT_NE(local.isPreferredOver(remote), remote.isPreferredOver(local));
+}
+
+/*
+ * Test the serialization of the version.
+ */
+TEST(VersionVectorTest, TestSerialization)
+{
+    data_sync::VersionVector version;
+    version.increment("bmc0");
+    version.increment("bmc1");
+    version.increment("bmc1");
+
+    EXPECT_EQ(version.toString(), "bmc0:1,bmc1:2");
+    EXPECT_EQ(data_sync::VersionVector::fromString(version.toString()),
+              version);
+    EXPECT_EQ(data_sync::VersionVector::fromString(""),
+              data_sync::VersionVector{});
+
+    EXPECT_EQ(data_sync::VersionVector::fromString("bmc0"), std::nullopt);
+    EXPECT_EQ(data_sync::VersionVector::fromString("bmc0:x"), std::nullopt);
+    EXPECT_EQ(data_sync::VersionVector::fromString(":1"), std::nullopt);
+}
+
+/*
+ * Test that the version is kept in the file and the store is persisted.
+ */
+TEST(VersionVectorTest, TestFileVersionAndStore)
+{
+    char tmpDir[] = "/tmp/version_vector_testXXXXXX";
+    const fs::path dir = mkdtemp(tmpDir);
+    const auto file = dir / "file";
+    std::ofstream(file) << "content";
+
+    data_sync::VersionVector version;
+    version.increment("bmc0");
+
+    EXPECT_EQ(data_sync::VersionVector::read(file), std::nullopt);
+    if (version.write(file))
+    {
+        EXPECT_EQ(data_sync::VersionVector::read(file), version);
+    }
+
+    {
+        data_sync::VersionStore store(dir / "store.json");
+        EXPECT_EQ(store.get(file), data_sync::VersionVector{});
+        store.set(file, version);
+        EXPECT_TRUE(store.isDirty());
+        store.persist();
+        EXPECT_FALSE(store.isDirty());
+    }
+
+    data_sync::VersionStore store(dir / "store.json");
+    EXPECT_EQ(store.get(file), version);
+
+    fs::remove_all(dir);
+}